@@ -8,6 +8,7 @@
 
 #include "Amber/Renderer/Framebuffer.h"
 #include "Amber/Renderer/Renderer.h"
+#include "Amber/Renderer/SceneRenderer.h"
 
 #include "Amber/Script/ScriptEngine.h"
 
@@ -109,6 +110,20 @@ void Application::RenderImGui()
     ImGui::Text("Renderer: %s", caps.Renderer.c_str());
     ImGui::Text("Version: %s", caps.Version.c_str());
     ImGui::Text("Frame Time: %.2fms", m_Timestep.GetMilliseconds());
+
+    ImGui::Separator();
+    auto stats = SceneRenderer::GetStats();
+    ImGui::Text("Render Passes: %u (%u culled)", stats.RenderGraphPasses, stats.CulledRenderGraphPasses);
+    for (auto& result : Renderer::GetGPUProfiler()->GetResults())
+    {
+        int indent = (int)result.Depth * 2;
+        if (result.Count > 1)
+            ImGui::Text("%*s%s (x%u): %.2fms", indent, "", result.Name.c_str(), result.Count, result.Milliseconds);
+        else
+            ImGui::Text("%*s%s: %.2fms", indent, "", result.Name.c_str(), result.Milliseconds);
+    }
+    ImGui::Text("Render Targets: %.1fMB", stats.RenderTargetMemory / (1024.0f * 1024.0f));
+    ImGui::Text("GPU Scene: %u objects, %u uploaded in %u ranges", stats.GPUSceneObjects, stats.GPUSceneUploadedObjects, stats.GPUSceneUploadRanges);
     ImGui::End();
 
     for (Layer* layer : m_LayerStack)
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Amber
+{
+
+namespace Hash
+{
+
+// 32-bit FNV-1a, usable at compile time for string literals
+constexpr uint32_t FNV(const char* str)
+{
+    uint32_t hash = 2166136261u;
+    while (*str)
+    {
+        hash ^= (uint32_t)(uint8_t)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+inline uint32_t FNV(const std::string& str)
+{
+    return FNV(str.c_str());
+}
+
+constexpr uint64_t FNV64OffsetBasis = 14695981039346656037ull;
+
+// 64-bit FNV-1a over raw bytes, pass the previous result to hash several pieces as one
+inline uint64_t FNV64(const void* data, size_t size, uint64_t hash = FNV64OffsetBasis)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+inline uint64_t FNV64(const std::string& str, uint64_t hash = FNV64OffsetBasis)
+{
+    return FNV64(str.data(), str.size(), hash);
+}
+
+}
+
+}
@@ -1,20 +1,27 @@
 #pragma once
 
+#include <atomic>
 #include <stdint.h>
 
 namespace Amber
 {
 
+// The count is atomic so render commands can be recorded on worker threads.
+// Copies start with no references of their own.
 class RefCounted
 {
 public:
-    void IncRefCount() const { m_RefCount++; }
-    void DecRefCount() const { m_RefCount--; }
+    RefCounted() = default;
+    RefCounted(const RefCounted&) {}
+    RefCounted& operator=(const RefCounted&) { return *this; }
 
-    uint32_t GetRefCount() const { return m_RefCount; }
+    void IncRefCount() const { m_RefCount.fetch_add(1, std::memory_order_relaxed); }
+    uint32_t DecRefCount() const { return m_RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+    uint32_t GetRefCount() const { return m_RefCount.load(std::memory_order_relaxed); }
 
 private:
-    mutable uint32_t m_RefCount = 0;
+    mutable std::atomic<uint32_t> m_RefCount{ 0 };
 };
 
 template<typename T>
@@ -183,8 +190,7 @@ private:
     {
         if (m_Instance)
         {
-            m_Instance->DecRefCount();
-            if (m_Instance->GetRefCount() == 0)
+            if (m_Instance->DecRefCount() == 0)
                 delete m_Instance;
         }
     }
@@ -87,6 +87,30 @@ public:
         }
     }
 
+    // GPU scopes go on their own track, already converted to the CPU clock
+    void WriteGPUProfile(const std::string& name, double start, double duration)
+    {
+        std::stringstream json;
+
+        json << std::setprecision(3) << std::fixed;
+        json << ",{";
+        json << "\"cat\":\"gpu\",";
+        json << "\"dur\":" << duration << ',';
+        json << "\"name\":\"" << name << "\",";
+        json << "\"ph\":\"X\",";
+        json << "\"pid\":1,";
+        json << "\"tid\":0,";
+        json << "\"ts\":" << start;
+        json << "}";
+
+        std::lock_guard lock(m_Mutex);
+        if (m_CurrentSession)
+        {
+            m_OutputStream << json.str();
+            m_OutputStream.flush();
+        }
+    }
+
     static Instrumentor& Get()
     {
         static Instrumentor instance;
@@ -71,6 +71,12 @@ void ParticleSystem::Emit(const ParticleProps& properties, uint32_t particleCoun
 
 
 void ParticleSystem::OnUpdate(Timestep ts)
+{
+    glm::vec2 limit(std::numeric_limits<float>::max());
+    OnUpdate(ts, Math::Rect(-limit, limit));
+}
+
+void ParticleSystem::OnUpdate(Timestep ts, const Math::Rect& view)
 {
     uint32_t idx;
     switch (m_ParticleType)
@@ -83,7 +89,9 @@ void ParticleSystem::OnUpdate(Timestep ts)
             idx = (m_PoolIndex + 1) % m_PoolSize;
             break;
     }
-    
+
+    uint32_t first = idx;
+    m_Bounds = Math::Rect();
     for (uint32_t i = 0; i < m_PoolSize; i++, idx = (idx + 1) % m_PoolSize)
     {
         auto& particle = m_ParticlePool[idx];
@@ -102,8 +110,29 @@ void ParticleSystem::OnUpdate(Timestep ts)
         if (particle.DoesRotate)
             particle.Rotation += glm::radians(180.0f * ts);
 
+        // Half the diagonal covers the quad at any rotation
+        float extent = glm::max(particle.SizeBegin, particle.SizeEnd) * 0.7072f;
+        m_Bounds.Min = glm::min(m_Bounds.Min, particle.Position - extent);
+        m_Bounds.Max = glm::max(m_Bounds.Max, particle.Position + extent);
+    }
+
+    if (!m_Bounds.IsValid() || !m_Bounds.Intersects(view))
+        return;
+
+    idx = first;
+    for (uint32_t i = 0; i < m_PoolSize; i++, idx = (idx + 1) % m_PoolSize)
+    {
+        auto& particle = m_ParticlePool[idx];
+        if (!particle.Active)
+            continue;
+
         float life = particle.LifeRemaining / particle.Lifetime;
         float size = glm::lerp(particle.SizeEnd, particle.SizeBegin, life);
+
+        float extent = size * 0.7072f;
+        if (!Math::Rect(particle.Position - extent, particle.Position + extent).Intersects(view))
+            continue;
+
         glm::vec4 color = glm::lerp(particle.ColorEnd, particle.ColorBegin, life);
 
         Renderer2D::QuadData data(particle.Position, particle.Rotation, { size, size }, m_ParticleTexture);
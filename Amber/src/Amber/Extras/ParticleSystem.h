@@ -4,6 +4,8 @@
 
 #include "Amber/Core/Time.h"
 
+#include "Amber/Math/Rect.h"
+
 #include "Amber/Renderer/Texture.h"
 
 namespace Amber
@@ -33,6 +35,10 @@ public:
     void Emit(const ParticleProps& properties, uint32_t particleCount);
 
     void OnUpdate(Timestep ts);
+    // Particles outside the view are still simulated, the whole emitter is skipped when its bounds are
+    void OnUpdate(Timestep ts, const Math::Rect& view);
+
+    const Math::Rect& GetBounds() const { return m_Bounds; }
 
 private:
     struct Particle
@@ -54,6 +60,7 @@ private:
     std::vector<Particle> m_ParticlePool;
     ParticleType m_ParticleType;
     Ref<Texture2D> m_ParticleTexture;
+    Math::Rect m_Bounds;
 };
 
 }
@@ -0,0 +1,124 @@
+#include "abpch.h"
+#include "LooseGrid.h"
+
+namespace Amber
+{
+namespace Math
+{
+
+LooseGrid::LooseGrid(float cellSize)
+    : m_CellSize(cellSize)
+{
+}
+
+uint64_t LooseGrid::GetCellKey(const glm::ivec2& cell) const
+{
+    return ((uint64_t)(uint32_t)cell.x << 32) | (uint64_t)(uint32_t)cell.y;
+}
+
+void LooseGrid::AddToCell(uint32_t id)
+{
+    auto& item = m_Items[id];
+    auto& items = item.Oversized ? m_Oversized : m_Cells[item.CellKey];
+    item.Index = (uint32_t)items.size();
+    items.push_back(id);
+}
+
+void LooseGrid::RemoveFromCell(uint32_t id)
+{
+    const auto& item = m_Items[id];
+    auto& items = item.Oversized ? m_Oversized : m_Cells[item.CellKey];
+    uint32_t index = item.Index;
+
+    items[index] = items.back();
+    m_Items[items[index]].Index = index;
+    items.pop_back();
+
+    if (items.empty() && !item.Oversized)
+        m_Cells.erase(item.CellKey);
+}
+
+void LooseGrid::Update(uint32_t id, const Rect& bounds)
+{
+    glm::vec2 size = bounds.Max - bounds.Min;
+    bool oversized = size.x > m_CellSize || size.y > m_CellSize;
+    uint64_t key = oversized ? 0 : GetCellKey(glm::ivec2(glm::floor((bounds.Min + bounds.Max) * 0.5f / m_CellSize)));
+
+    auto it = m_Items.find(id);
+    if (it != m_Items.end())
+    {
+        it->second.Bounds = bounds;
+        if (it->second.Oversized == oversized && it->second.CellKey == key)
+            return;
+
+        RemoveFromCell(id);
+        it->second.CellKey = key;
+        it->second.Oversized = oversized;
+    }
+    else
+    {
+        m_Items[id] = { bounds, key, oversized, 0 };
+    }
+
+    AddToCell(id);
+}
+
+void LooseGrid::Remove(uint32_t id)
+{
+    auto it = m_Items.find(id);
+    if (it == m_Items.end())
+        return;
+
+    RemoveFromCell(id);
+    m_Items.erase(id);
+}
+
+void LooseGrid::Clear()
+{
+    m_Items.clear();
+    m_Cells.clear();
+    m_Oversized.clear();
+}
+
+void LooseGrid::Query(const Rect& area, std::vector<uint32_t>& outItems) const
+{
+    auto test = [&](const std::vector<uint32_t>& items) {
+        for (uint32_t id : items)
+        {
+            if (m_Items.at(id).Bounds.Intersects(area))
+                outItems.push_back(id);
+        }
+    };
+
+    test(m_Oversized);
+
+    // An item reaches at most half a cell past the cell holding its center
+    glm::ivec2 first = glm::ivec2(glm::floor(area.Min / m_CellSize)) - 1;
+    glm::ivec2 last = glm::ivec2(glm::floor(area.Max / m_CellSize)) + 1;
+    glm::dvec2 span = glm::dvec2(last - first) + 1.0;
+
+    // Zoomed far out, walking the occupied cells is cheaper than walking the covered ones
+    if (span.x * span.y > (double)m_Cells.size())
+    {
+        for (auto& [key, items] : m_Cells)
+        {
+            glm::ivec2 cell((int32_t)(uint32_t)(key >> 32), (int32_t)(uint32_t)key);
+            if (cell.x >= first.x && cell.x <= last.x && cell.y >= first.y && cell.y <= last.y)
+                test(items);
+        }
+        return;
+    }
+
+    for (int32_t y = first.y; y <= last.y; y++)
+    {
+        for (int32_t x = first.x; x <= last.x; x++)
+        {
+            auto it = m_Cells.find(GetCellKey({ x, y }));
+            if (it != m_Cells.end())
+                test(it->second);
+        }
+    }
+}
+
+} // Math
+} // Amber
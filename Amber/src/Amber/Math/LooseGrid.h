@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Amber/Math/Rect.h"
+
+namespace Amber
+{
+namespace Math
+{
+
+// 2D spatial hash where an item lives only in the cell holding its center. Items no larger than a
+// cell therefore never straddle more than the neighbouring cells, which queries widen by.
+// Larger items are kept aside and tested on every query.
+class LooseGrid
+{
+public:
+    LooseGrid(float cellSize = 8.0f);
+
+    // Inserts the item or moves it, only touching the cells when its center changes cell
+    void Update(uint32_t id, const Rect& bounds);
+    void Remove(uint32_t id);
+    void Clear();
+
+    // Appends the items whose bounds intersect the area
+    void Query(const Rect& area, std::vector<uint32_t>& outItems) const;
+
+    uint32_t GetItemCount() const { return (uint32_t)m_Items.size(); }
+    uint32_t GetCellCount() const { return (uint32_t)m_Cells.size(); }
+
+private:
+    uint64_t GetCellKey(const glm::ivec2& cell) const;
+    void AddToCell(uint32_t id);
+    void RemoveFromCell(uint32_t id);
+
+    struct Item
+    {
+        Rect Bounds;
+        // Every value is a valid cell, so oversized items are flagged separately
+        uint64_t CellKey;
+        bool Oversized;
+        uint32_t Index;
+    };
+
+    float m_CellSize;
+    std::unordered_map<uint32_t, Item> m_Items;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_Cells;
+    std::vector<uint32_t> m_Oversized;
+};
+
+} // Math
+} // Amber
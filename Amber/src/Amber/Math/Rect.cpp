@@ -0,0 +1,100 @@
+#include "abpch.h"
+#include "Rect.h"
+
+namespace Amber
+{
+namespace Math
+{
+
+Rect::Rect()
+    : Min(std::numeric_limits<float>::max()), Max(-std::numeric_limits<float>::max())
+{
+}
+
+Rect::Rect(const glm::vec2& min, const glm::vec2& max)
+    : Min(min), Max(max)
+{
+}
+
+bool Rect::Intersects(const Rect& other) const
+{
+    if ((Max.x < other.Min.x) || (Min.x > other.Max.x) ||
+        (Max.y < other.Min.y) || (Min.y > other.Max.y))
+        return false;
+    return true;
+}
+
+Rect Rect::FromQuad(const glm::mat4& transform)
+{
+    glm::vec2 center(transform[3]);
+    glm::vec2 extents = glm::abs(glm::vec2(transform[0]) * 0.5f) + glm::abs(glm::vec2(transform[1]) * 0.5f);
+    return Rect(center - extents, center + extents);
+}
+
+bool Rect::FromOrthographicView(const glm::mat4& viewProjection, Rect& outRect)
+{
+    if (viewProjection[0][3] != 0.0f || viewProjection[1][3] != 0.0f || viewProjection[2][3] != 0.0f)
+        return false;
+
+    glm::mat4 inverse = glm::inverse(viewProjection);
+    outRect = Rect();
+    for (float x : { -1.0f, 1.0f })
+    {
+        for (float y : { -1.0f, 1.0f })
+        {
+            for (float z : { -1.0f, 1.0f })
+            {
+                glm::vec4 corner = inverse * glm::vec4(x, y, z, 1.0f);
+                glm::vec2 point = glm::vec2(corner) / corner.w;
+                outRect.Min = glm::min(outRect.Min, point);
+                outRect.Max = glm::max(outRect.Max, point);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Rect::FromView(const glm::mat4& viewProjection, float minZ, float maxZ, Rect& outRect)
+{
+    // Corners are indexed by their NDC signs, bit 0 for x, bit 1 for y and bit 2 for z
+    glm::mat4 inverse = glm::inverse(viewProjection);
+    glm::vec3 corners[8];
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        glm::vec4 corner = inverse * glm::vec4(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f);
+        corners[i] = glm::vec3(corner) / corner.w;
+    }
+
+    // The clipped volume's vertices are the corners inside the slab and the points where edges cross its planes
+    outRect = Rect();
+    auto add = [&](const glm::vec3& point) {
+        outRect.Min = glm::min(outRect.Min, glm::vec2(point));
+        outRect.Max = glm::max(outRect.Max, glm::vec2(point));
+    };
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        if (corners[i].z >= minZ && corners[i].z <= maxZ)
+            add(corners[i]);
+
+        for (uint32_t axis = 1; axis < 8; axis <<= 1)
+        {
+            if (i & axis)
+                continue;
+
+            const glm::vec3& a = corners[i];
+            const glm::vec3& b = corners[i | axis];
+            for (float z : { minZ, maxZ })
+            {
+                if ((a.z - z) * (b.z - z) < 0.0f)
+                    add(glm::mix(a, b, (z - a.z) / (b.z - a.z)));
+            }
+        }
+    }
+
+    return outRect.IsValid();
+}
+
+} // Math
+} // Amber
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Amber
+{
+namespace Math
+{
+
+struct Rect
+{
+    glm::vec2 Min, Max;
+
+    Rect();
+    Rect(const glm::vec2& min, const glm::vec2& max);
+
+    bool Intersects(const Rect& other) const;
+    bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y; }
+
+    // XY bounds of the transformed unit quad, as drawn by Renderer2D
+    static Rect FromQuad(const glm::mat4& transform);
+    // Area an orthographic view projection sees, false for perspective projections
+    static bool FromOrthographicView(const glm::mat4& viewProjection, Rect& outRect);
+    // XY area of the part of any view projection between two Z values, false when the view misses them
+    static bool FromView(const glm::mat4& viewProjection, float minZ, float maxZ, Rect& outRect);
+};
+
+} // Math
+} // Amber
@@ -0,0 +1,87 @@
+#include "abpch.h"
+#include "OpenGLComputePipeline.h"
+
+#include <glad/glad.h>
+
+#include "Amber/Renderer/RenderCommand.h"
+
+namespace Amber
+{
+
+static GLenum ImageAccessToOpenGLAccess(ImageAccess access)
+{
+    switch (access)
+    {
+        case ImageAccess::ReadOnly:     return GL_READ_ONLY;
+        case ImageAccess::WriteOnly:    return GL_WRITE_ONLY;
+        case ImageAccess::ReadWrite:    return GL_READ_WRITE;
+    }
+
+    AB_CORE_ASSERT(false, "Unknown image access!");
+    return 0;
+}
+
+static GLenum TextureFormatToOpenGLImageFormat(TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::R:              return GL_R8;
+        case TextureFormat::RG:             return GL_RG8;
+        case TextureFormat::RGBA:           return GL_RGBA8;
+        case TextureFormat::Float16:        return GL_RGBA16F;
+        case TextureFormat::R11G11B10F:     return GL_R11F_G11F_B10F;
+    }
+
+    AB_CORE_ASSERT(false, "Texture format cannot be bound as an image!");
+    return 0;
+}
+
+OpenGLComputePipeline::OpenGLComputePipeline(const ComputePipelineSpecification& spec)
+    : m_Specification(spec)
+{
+    AB_CORE_ASSERT(m_Specification.Shader, "Compute pipeline needs a shader!");
+}
+
+void OpenGLComputePipeline::Bind()
+{
+    m_Specification.Shader->Bind();
+}
+
+void OpenGLComputePipeline::BindImage(uint32_t binding, const Ref<Texture>& texture, uint32_t mipLevel, ImageAccess access)
+{
+    AB_CORE_ASSERT(mipLevel < texture->GetMipLevelCount(), "Mip level out of range!");
+
+    GLenum format = TextureFormatToOpenGLImageFormat(texture->GetFormat());
+    GLenum glAccess = ImageAccessToOpenGLAccess(access);
+    RenderCommand::Submit([binding, texture, mipLevel, glAccess, format]() {
+        glBindImageTexture(binding, texture->GetRendererID(), mipLevel, GL_TRUE, 0, glAccess, format);
+    });
+}
+
+void OpenGLComputePipeline::BindTexture(uint32_t slot, const Ref<Texture>& texture)
+{
+    texture->Bind(slot);
+}
+
+void OpenGLComputePipeline::BindStorageBuffer(uint32_t binding, const Ref<StorageBuffer>& buffer)
+{
+    buffer->Bind(binding);
+}
+
+void OpenGLComputePipeline::SetInt(uint32_t location, int32_t value)
+{
+    Ref<Shader> shader = m_Specification.Shader;
+    RenderCommand::Submit([shader, location, value]() {
+        glProgramUniform1i(shader->GetRendererID(), location, value);
+    });
+}
+
+void OpenGLComputePipeline::SetFloat(uint32_t location, float value)
+{
+    Ref<Shader> shader = m_Specification.Shader;
+    RenderCommand::Submit([shader, location, value]() {
+        glProgramUniform1f(shader->GetRendererID(), location, value);
+    });
+}
+
+}
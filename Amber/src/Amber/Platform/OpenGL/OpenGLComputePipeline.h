@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Amber/Renderer/ComputePipeline.h"
+
+namespace Amber
+{
+
+class OpenGLComputePipeline : public ComputePipeline
+{
+public:
+    OpenGLComputePipeline(const ComputePipelineSpecification& spec);
+
+    void Bind() override;
+
+    void BindImage(uint32_t binding, const Ref<Texture>& texture, uint32_t mipLevel = 0, ImageAccess access = ImageAccess::WriteOnly) override;
+    void BindTexture(uint32_t slot, const Ref<Texture>& texture) override;
+    void BindStorageBuffer(uint32_t binding, const Ref<StorageBuffer>& buffer) override;
+
+    void SetInt(uint32_t location, int32_t value) override;
+    void SetFloat(uint32_t location, float value) override;
+
+    ComputePipelineSpecification& GetSpecification() override { return m_Specification; }
+    const ComputePipelineSpecification& GetSpecification() const override { return m_Specification; }
+
+private:
+    ComputePipelineSpecification m_Specification;
+};
+
+}
@@ -33,6 +33,15 @@ void OpenGLContext::Init()
     glGetIntegerv(GL_MINOR_VERSION, &versionMinor);
 
     AB_CORE_ASSERT(versionMajor > 4 || (versionMajor == 4 && versionMinor >= 5), "Amber requires at least OpenGL version 4.5!");
+
+    // Lets the driver compile shaders on as many threads as it likes, the generated loader doesn't include the extension
+    if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+    {
+        typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+        auto maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+        if (maxShaderCompilerThreads)
+            maxShaderCompilerThreads(0xFFFFFFFF);
+    }
 }
 
 void OpenGLContext::SwapBuffers()
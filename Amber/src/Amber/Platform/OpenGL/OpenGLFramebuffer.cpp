@@ -13,7 +13,9 @@ static TextureFormat FramebufferFormatToTextureFormat(const FramebufferFormat& f
     switch (framebufferFormat)
     {
         case FramebufferFormat::RGBA8: return TextureFormat::RGBA;
+        case FramebufferFormat::RGBA8_SRGB: return TextureFormat::SRGBA;
         case FramebufferFormat::RGBA16F: return TextureFormat::Float16;
+        case FramebufferFormat::R11G11B10F: return TextureFormat::R11G11B10F;
     }
 
     AB_CORE_ASSERT(false, "Framebuffer format not recognized!");
@@ -25,7 +27,6 @@ OpenGLFramebuffer::OpenGLFramebuffer(const FramebufferSpecification& spec)
 {
     m_ColorAttachments.reserve(m_Specification.ColorAttachmentCount);
     Reset();
-    FramebufferPool::GetGlobal()->Add(WeakRef<Framebuffer>(this));
 }
 
 OpenGLFramebuffer::~OpenGLFramebuffer()
@@ -37,9 +38,7 @@ OpenGLFramebuffer::~OpenGLFramebuffer()
         for (auto colorAttachment : m_ColorAttachments)
             colorAttachment.Reset();
         
-        if (m_Specification.DepthAttachmentType == DepthBufferType::Texture)
-            glDeleteTextures(1, &m_DepthAttachment);
-        else
+        if (m_Specification.DepthAttachmentType == DepthBufferType::Renderbuffer)
             glDeleteRenderbuffers(1, &m_DepthAttachment);
     });
 }
@@ -65,10 +64,20 @@ void OpenGLFramebuffer::Reset()
     if (m_Specification.Samples > 1)
         m_Specification.DepthAttachmentType = DepthBufferType::Texture;
 
+    Ref<Texture2D> newDepthTexture;
+    if (m_Specification.DepthAttachmentType == DepthBufferType::Texture)
+    {
+        newDepthTexture = Texture2D::Create(
+            m_Specification.StencilBuffer ? TextureFormat::DepthStencil : TextureFormat::Depth,
+            m_Specification.Width, m_Specification.Height,
+            TextureWrap::Clamp, TextureFilter::Nearest,
+            m_Specification.Samples);
+    }
+
     uint32_t width = m_Specification.Width;
     uint32_t height = m_Specification.Height;
     Ref<OpenGLFramebuffer> instance = this;
-    RenderCommand::Submit([instance, width, height, newColorAttachments]() mutable {
+    RenderCommand::Submit([instance, width, height, newColorAttachments, newDepthTexture]() mutable {
         AB_PROFILE_FUNCTION();
 
         instance->m_ColorAttachments.swap(newColorAttachments);
@@ -77,34 +86,11 @@ void OpenGLFramebuffer::Reset()
 
         if (instance->m_Specification.DepthAttachmentType == DepthBufferType::Texture)
         {
-            if (instance->m_DepthAttachment)
-                glDeleteTextures(1, &instance->m_DepthAttachment);
-
-            if (multisample)
-            {
-                glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &instance->m_DepthAttachment);
-                glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, instance->m_DepthAttachment);
-                glTextureStorage2DMultisample(
-                    instance->m_DepthAttachment,
-                    instance->m_Specification.Samples,
-                    instance->m_Specification.StencilBuffer ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT32,
-                    width, height, GL_FALSE);
-            }
-            else
-            {
-                glCreateTextures(GL_TEXTURE_2D, 1, &instance->m_DepthAttachment);
-                glBindTexture(GL_TEXTURE_2D, instance->m_DepthAttachment);
-
-                glTextureParameteri(instance->m_DepthAttachment, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTextureParameteri(instance->m_DepthAttachment, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glTextureParameteri(instance->m_DepthAttachment, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTextureParameteri(instance->m_DepthAttachment, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            if (!instance->m_DepthTexture && instance->m_DepthAttachment)
+                glDeleteRenderbuffers(1, &instance->m_DepthAttachment);
 
-                glTextureStorage2D(
-                    instance->m_DepthAttachment, 1,
-                    instance->m_Specification.StencilBuffer ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT32,
-                    width, height);
-            }
+            instance->m_DepthTexture = newDepthTexture;
+            instance->m_DepthAttachment = newDepthTexture->GetRendererID();
         }
         else if (instance->m_Specification.DepthAttachmentType == DepthBufferType::Renderbuffer)
         {
@@ -174,6 +160,12 @@ void OpenGLFramebuffer::Reset()
                     GL_RENDERBUFFER, instance->m_DepthAttachment);
             }
         }
+
+        if (instance->m_Specification.ColorAttachmentCount == 0)
+        {
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
         AB_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -210,4 +202,18 @@ void OpenGLFramebuffer::Unbind() const
     });
 }
 
+void OpenGLFramebuffer::BlitTo(const Ref<Framebuffer>& target, uint32_t width, uint32_t height) const
+{
+    Ref<const OpenGLFramebuffer> instance = this;
+    RenderCommand::Submit([instance, target, width, height]() {
+        AB_PROFILE_FUNCTION();
+
+        glBlitNamedFramebuffer(
+            instance->m_RendererID, target->GetRendererID(),
+            0, 0, width, height,
+            0, 0, width, height,
+            GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    });
+}
+
 }
\ No newline at end of file
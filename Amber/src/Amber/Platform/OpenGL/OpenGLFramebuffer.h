@@ -16,10 +16,13 @@ public:
 
     void Bind() const override;
     void Unbind() const override;
+
+    void BlitTo(const Ref<Framebuffer>& target, uint32_t width, uint32_t height) const override;
     
     RendererID GetRendererID() const override { return m_RendererID; }
     const std::vector<Ref<Texture2D>>& GetColorAttachments() const override { return m_ColorAttachments; }
     RendererID GetDepthAttachment() const override { return m_DepthAttachment; }
+    const Ref<Texture2D>& GetDepthTexture() const override { return m_DepthTexture; }
     
     FramebufferSpecification& GetSpecification() override { return m_Specification; }
     const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
@@ -27,7 +30,7 @@ public:
 private:
     RendererID m_RendererID = 0;
     std::vector<Ref<Texture2D>> m_ColorAttachments;
-    // TODO: Figure out a way to store the actual depth attachment object (texture / renderbuffer)
+    Ref<Texture2D> m_DepthTexture;
     RendererID m_DepthAttachment = 0;
     FramebufferSpecification m_Specification;
 };
@@ -0,0 +1,111 @@
+#include "abpch.h"
+#include "OpenGLGPUProfiler.h"
+
+#include <glad/glad.h>
+
+#include "Amber/Debug/Instrumentor.h"
+
+#include "Amber/Renderer/RenderCommand.h"
+
+namespace Amber
+{
+
+OpenGLGPUProfiler::~OpenGLGPUProfiler()
+{
+    std::vector<RendererID> queries;
+    for (auto& frame : m_Frames)
+        queries.insert(queries.end(), frame.Queries.begin(), frame.Queries.end());
+
+    RenderCommand::Submit([queries]() {
+        glDeleteQueries((GLsizei)queries.size(), queries.data());
+    });
+}
+
+void OpenGLGPUProfiler::BeginScope(const std::string& name)
+{
+    const char* scopeName = (const char*)RenderCommand::CopyPayload(name.c_str(), name.size() + 1);
+    Ref<OpenGLGPUProfiler> instance = this;
+    RenderCommand::Submit([instance, scopeName]() mutable {
+        auto& frame = instance->m_Frames[instance->m_FrameIndex];
+
+        uint32_t scopeIndex = (uint32_t)frame.Scopes.size();
+        if (frame.Queries.size() < (scopeIndex + 1) * 2)
+        {
+            frame.Queries.resize((scopeIndex + 1) * 2);
+            glGenQueries(2, &frame.Queries[scopeIndex * 2]);
+        }
+
+        frame.Scopes.push_back({ scopeName, (uint32_t)instance->m_OpenScopes.size() });
+        instance->m_OpenScopes.push_back(scopeIndex);
+
+        glQueryCounter(frame.Queries[scopeIndex * 2], GL_TIMESTAMP);
+    });
+}
+
+void OpenGLGPUProfiler::EndScope()
+{
+    Ref<OpenGLGPUProfiler> instance = this;
+    RenderCommand::Submit([instance]() mutable {
+        AB_CORE_ASSERT(!instance->m_OpenScopes.empty(), "No open GPU profiler scope!");
+
+        auto& frame = instance->m_Frames[instance->m_FrameIndex];
+        uint32_t scopeIndex = instance->m_OpenScopes.back();
+        instance->m_OpenScopes.pop_back();
+
+        glQueryCounter(frame.Queries[scopeIndex * 2 + 1], GL_TIMESTAMP);
+    });
+}
+
+void OpenGLGPUProfiler::EndFrame()
+{
+    Ref<OpenGLGPUProfiler> instance = this;
+    RenderCommand::Submit([instance]() mutable {
+        // Command buffers flushed in the middle of a frame keep recording into the same set
+        if (!instance->m_OpenScopes.empty())
+            return;
+
+        instance->m_FrameIndex = (instance->m_FrameIndex + 1) % s_BufferCount;
+        instance->ReadBack(instance->m_FrameIndex);
+        instance->m_Frames[instance->m_FrameIndex].Scopes.clear();
+    });
+}
+
+void OpenGLGPUProfiler::ReadBack(uint32_t frameIndex)
+{
+    auto& frame = m_Frames[frameIndex];
+    if (frame.Scopes.empty())
+        return;
+
+    // Timestamps complete in order, so the last one being ready means all of them are
+    GLint available = 0;
+    glGetQueryObjectiv(frame.Queries[frame.Scopes.size() * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return;
+
+    // Lines the GPU clock up with the CPU clock used by the Instrumentor trace
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    auto cpuNow = FloatingPointMicroseconds{ std::chrono::steady_clock::now().time_since_epoch() };
+
+    m_Results.clear();
+    for (uint32_t i = 0; i < frame.Scopes.size(); i++)
+    {
+        GLuint64 start, end;
+        glGetQueryObjectui64v(frame.Queries[i * 2], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(frame.Queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+
+        const auto& scope = frame.Scopes[i];
+        float milliseconds = (float)(end - start) / 1000000.0f;
+
+        auto it = std::find_if(m_Results.begin(), m_Results.end(), [&](const Result& result) { return result.Name == scope.Name; });
+        if (it == m_Results.end())
+            it = m_Results.insert(m_Results.end(), { scope.Name, scope.Depth, 0, 0.0f });
+        it->Count++;
+        it->Milliseconds += milliseconds;
+
+        double startMicroseconds = cpuNow.count() - (double)(gpuNow - (GLint64)start) / 1000.0;
+        Instrumentor::Get().WriteGPUProfile(scope.Name, startMicroseconds, (double)(end - start) / 1000.0);
+    }
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Amber/Renderer/GPUProfiler.h"
+
+namespace Amber
+{
+
+class OpenGLGPUProfiler : public GPUProfiler
+{
+public:
+    ~OpenGLGPUProfiler();
+
+    void BeginScope(const std::string& name) override;
+    void EndScope() override;
+    void EndFrame() override;
+
+    const std::vector<Result>& GetResults() const override { return m_Results; }
+
+private:
+    void ReadBack(uint32_t frameIndex);
+
+    static const uint32_t s_BufferCount = 2;
+
+    struct TimedScope
+    {
+        std::string Name;
+        uint32_t Depth;
+    };
+
+    struct Frame
+    {
+        std::vector<TimedScope> Scopes;
+        // Start and end timestamp per scope, grown on demand and reused across frames
+        std::vector<RendererID> Queries;
+    };
+
+    Frame m_Frames[s_BufferCount];
+    uint32_t m_FrameIndex = 0;
+    std::vector<uint32_t> m_OpenScopes;
+
+    std::vector<Result> m_Results;
+};
+
+}
@@ -53,14 +53,14 @@ void OpenGLIndexBuffer::Unbind() const
 
 void OpenGLIndexBuffer::SetData(void* buffer, size_t size, uint32_t offset)
 {
-    m_LocalData = Buffer(buffer, size);
     m_Size = size;
 
+    const void* data = RenderCommand::CopyPayload(buffer, size);
     Ref<OpenGLIndexBuffer> instance = this;
-    RenderCommand::Submit([instance, offset]() {
+    RenderCommand::Submit([instance, data, size, offset]() {
         AB_PROFILE_FUNCTION();
 
-        glNamedBufferSubData(instance->m_RendererID, offset, instance->m_Size, instance->m_LocalData.Data);
+        glNamedBufferSubData(instance->m_RendererID, offset, size, data);
     });
 }
 
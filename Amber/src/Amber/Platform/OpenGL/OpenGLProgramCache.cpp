@@ -0,0 +1,120 @@
+#include "abpch.h"
+#include "OpenGLProgramCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+#include <glad/glad.h>
+
+#include "Amber/Core/Hash.h"
+
+#include "Amber/Renderer/RendererAPI.h"
+
+namespace Amber
+{
+
+static const char* s_CacheDirectory = "assets/cache/shader";
+
+static const uint32_t s_Magic = 0x4e494250;  // "PBIN"
+
+// Bump whenever the way programs are built changes so stale entries are not picked up
+static const uint32_t s_CacheVersion = 1;
+
+struct ProgramBinaryHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t Format;
+    uint32_t Size;
+};
+
+std::string OpenGLProgramCache::GetCachePath(const std::string& name, uint64_t sourceHash)
+{
+    // Drivers without binary formats can't give us anything to store
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount == 0)
+        return "";
+
+    const auto& caps = RendererAPI::GetCapabilities();
+    uint64_t hash = Hash::FNV64(&s_CacheVersion, sizeof(s_CacheVersion), sourceHash);
+    hash = Hash::FNV64(caps.Vendor, hash);
+    hash = Hash::FNV64(caps.Renderer, hash);
+    hash = Hash::FNV64(caps.Version, hash);
+
+    std::string fileName = name;
+    std::replace_if(fileName.begin(), fileName.end(), [](char c) { return !isalnum((unsigned char)c) && c != '_'; }, '_');
+
+    std::stringstream ss;
+    ss << s_CacheDirectory << "/" << fileName << "-" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+    return ss.str();
+}
+
+RendererID OpenGLProgramCache::Load(const std::string& path)
+{
+    AB_PROFILE_FUNCTION();
+
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in)
+        return 0;
+
+    ProgramBinaryHeader header{};
+    in.read((char*)&header, sizeof(header));
+    if (!in || header.Magic != s_Magic || header.Version != s_CacheVersion || header.Size == 0)
+    {
+        AB_CORE_WARN("Ignoring invalid program cache file '{0}'", path);
+        return 0;
+    }
+
+    std::vector<char> binary(header.Size);
+    in.read(binary.data(), header.Size);
+    if (!in)
+    {
+        AB_CORE_WARN("Program cache file '{0}' is truncated", path);
+        return 0;
+    }
+
+    RendererID program = glCreateProgram();
+    glProgramBinary(program, header.Format, binary.data(), (GLsizei)header.Size);
+
+    // Driver updates can invalidate binaries without changing the version string
+    int32_t status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        AB_CORE_WARN("Driver rejected program cache file '{0}', recompiling", path);
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+void OpenGLProgramCache::Store(const std::string& path, RendererID program)
+{
+    AB_PROFILE_FUNCTION();
+
+    int32_t length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length == 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    if (!out)
+    {
+        AB_CORE_WARN("Could not write program cache file '{0}'", path);
+        return;
+    }
+
+    ProgramBinaryHeader header{ s_Magic, s_CacheVersion, format, (uint32_t)length };
+    out.write((const char*)&header, sizeof(header));
+    out.write(binary.data(), length);
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+#include "Amber/Core/Base.h"
+
+namespace Amber
+{
+
+// Linked program binaries from glGetProgramBinary, only valid for the driver that produced them
+class OpenGLProgramCache
+{
+public:
+    // Keyed by the shader source and the vendor, renderer and version of the driver
+    static std::string GetCachePath(const std::string& name, uint64_t sourceHash);
+
+    // Returns a linked program, or 0 when there is no entry or the driver rejects it
+    static RendererID Load(const std::string& path);
+    static void Store(const std::string& path, RendererID program);
+};
+
+}
@@ -114,6 +114,11 @@ void OpenGLRendererAPI::Init()
     glGetIntegerv(GL_MAX_COLOR_TEXTURE_SAMPLES, &caps.MaxTextureSamples);
     glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &caps.MaxTextureSlots);
 
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; i++)
+        caps.Extensions.insert((const char*)glGetStringi(GL_EXTENSIONS, i));
+
     GLenum error = glGetError();
     while (error != GL_NO_ERROR)
     {
@@ -152,6 +157,11 @@ void OpenGLRendererAPI::SetRasterizationMode(RasterizationMode mode)
     glPolygonMode(GL_FRONT_AND_BACK, RasterizationModeToGLMode(mode));
 }
 
+void OpenGLRendererAPI::SetDepthFunction(ComparisonFunc func)
+{
+    glDepthFunc(ComparisonFuncToGLFunc(func));
+}
+
 void OpenGLRendererAPI::SetStencilFunction(ComparisonFunc func, uint8_t ref, uint8_t mask)
 {
     glStencilFunc(ComparisonFuncToGLFunc(func), ref, mask);
@@ -169,6 +179,41 @@ void OpenGLRendererAPI::SetStencilOperation(StencilOperation stencilFail, Stenci
                 StencilOperationToGLOperation(depthPass));
 }
 
+void OpenGLRendererAPI::Barrier(uint32_t barriers)
+{
+    GLbitfield bits = 0;
+    if (barriers & (uint32_t)BarrierType::ShaderImageAccess)
+        bits |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+    if (barriers & (uint32_t)BarrierType::TextureFetch)
+        bits |= GL_TEXTURE_FETCH_BARRIER_BIT;
+    if (barriers & (uint32_t)BarrierType::ShaderStorage)
+        bits |= GL_SHADER_STORAGE_BARRIER_BIT;
+    if (barriers & (uint32_t)BarrierType::Command)
+        bits |= GL_COMMAND_BARRIER_BIT;
+    if (barriers & (uint32_t)BarrierType::Framebuffer)
+        bits |= GL_FRAMEBUFFER_BARRIER_BIT;
+    if (barriers & (uint32_t)BarrierType::TextureUpdate)
+        bits |= GL_TEXTURE_UPDATE_BARRIER_BIT;
+
+    if (bits)
+        glMemoryBarrier(bits);
+}
+
+void OpenGLRendererAPI::Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+{
+    if (groupsX == 0 || groupsY == 0 || groupsZ == 0)
+        return;
+
+    glDispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+void OpenGLRendererAPI::DispatchIndirect(RendererID argumentBuffer, uint32_t offset)
+{
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, argumentBuffer);
+    glDispatchComputeIndirect((GLintptr)offset);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+}
+
 void OpenGLRendererAPI::DrawIndexed(uint32_t indexCount, PrimitiveType type, bool depthTest, bool stencilTest)
 {
     if (indexCount == 0)
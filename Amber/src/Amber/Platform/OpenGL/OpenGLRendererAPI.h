@@ -18,10 +18,16 @@ public:
     void SetLineThickness(float thickness) override;
     void SetPointSize(float size) override;
     void SetRasterizationMode(RasterizationMode mode) override;
+    void SetDepthFunction(ComparisonFunc func) override;
     void SetStencilFunction(ComparisonFunc func, uint8_t ref, uint8_t mask) override;
     void SetStencilMask(uint8_t mask) override;
     void SetStencilOperation(StencilOperation stencilFail, StencilOperation depthFail, StencilOperation depthPass) override;
 
+    void Barrier(uint32_t barriers) override;
+
+    void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+    void DispatchIndirect(RendererID argumentBuffer, uint32_t offset) override;
+
     void DrawIndexed(uint32_t indexCount, PrimitiveType type = PrimitiveType::Triangles, bool depthTest = true, bool stencilTest = false) override;
     void DrawIndexedOffset(uint32_t indexCount, PrimitiveType type = PrimitiveType::Triangles, void* indexBufferPointer = 0, uint32_t offset = 0, bool depthTest = true, bool stencilTest = false) override;
 };
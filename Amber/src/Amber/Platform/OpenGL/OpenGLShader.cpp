@@ -7,8 +7,17 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Amber/Core/Hash.h"
+
 #include "Amber/Renderer/RenderCommand.h"
 
+#include "Amber/Platform/OpenGL/OpenGLProgramCache.h"
+
+// From GL_KHR_parallel_shader_compile, which the generated loader doesn't include
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace Amber
 {
 
@@ -28,6 +37,8 @@ uint32_t OpenGLShader::ShaderTypeFromString(const std::string& type)
 OpenGLShader::OpenGLShader(const std::string& filepath, ShaderType type)
     : m_AssetPath(filepath), m_Type(type)
 {
+    // Types that share a file with another one only differ in the keyword they enable
+    const char* typeKeyword = nullptr;
     switch (m_Type)
     {
         case ShaderType::None:
@@ -45,6 +56,7 @@ OpenGLShader::OpenGLShader(const std::string& filepath, ShaderType type)
 
         case ShaderType::StandardAnimated:
             m_Name = "Standard Animated";
+            typeKeyword = "ANIMATED";
             break;
 
         case ShaderType::UnlitColor:
@@ -56,49 +68,68 @@ OpenGLShader::OpenGLShader(const std::string& filepath, ShaderType type)
             break;
     }
 
-    Reload();
+    std::string source = ReadShaderFromFile();
+    DeclareKeywords(source);
+    if (typeKeyword)
+    {
+        m_Keywords = GetKeywordMask(typeKeyword);
+        AB_CORE_ASSERT(m_Keywords, "Shader does not declare the keyword of its type!");
+    }
+
+    Load(source);
 }
 
 OpenGLShader::OpenGLShader(const std::string& name, const std::string& source)
     : m_Name(name)
 {
+    DeclareKeywords(source);
     Load(source);
 }
 
+OpenGLShader::OpenGLShader(const OpenGLShader& base, uint32_t keywords)
+    : m_Name(base.m_Name), m_AssetPath(base.m_AssetPath), m_Type(base.m_Type),
+      m_KeywordNames(base.m_KeywordNames), m_KeywordTextures(base.m_KeywordTextures), m_Keywords(keywords)
+{
+    // Named after the keywords the base doesn't have, which also keeps their program cache entries apart
+    std::string added;
+    for (uint32_t i = 0; i < m_KeywordNames.size(); i++)
+    {
+        if ((keywords & ~base.m_Keywords) & (1u << i))
+            added += (added.empty() ? "" : " ") + m_KeywordNames[i];
+    }
+    if (!added.empty())
+        m_Name += " [" + added + "]";
+
+    Load(base.m_Source);
+}
+
 OpenGLShader::~OpenGLShader()
 {
-    RendererID rendererID = m_RendererID;
-    RenderCommand::Submit([rendererID]() {
+    RendererID rendererID = m_RendererID, pendingProgram = m_PendingProgram;
+    RenderCommand::Submit([rendererID, pendingProgram]() {
         AB_PROFILE_FUNCTION();
 
         glDeleteProgram(rendererID);
+        glDeleteProgram(pendingProgram);
     });
 }
 
-void OpenGLShader::Reload()
-{
-    std::string source = ReadShaderFromFile();
-    Load(source);
-}
-
 void OpenGLShader::Load(const std::string& source)
 {
+    m_Source = source;
+    m_SourceHash = Hash::FNV64(&m_Keywords, sizeof(m_Keywords), Hash::FNV64(source));
     PreProcess(source);
     if (!m_IsCompute)
         Parse();
 
+    // The compile is only waited on when the shader is first bound. Until then the driver can
+    // work on every queued shader at once where GL_KHR_parallel_shader_compile is available,
+    // and IsReady lets draws skip the shader instead of waiting.
     Ref<OpenGLShader> instance = this;
     RenderCommand::Submit([instance]() mutable {
         AB_PROFILE_FUNCTION();
 
-        if (instance->m_RendererID)
-            glDeleteProgram(instance->m_RendererID);
-
         instance->CompileAndUploadShader();
-        glUseProgram(instance->m_RendererID);
-
-        if (!instance->m_IsCompute)
-            instance->ResolveUniforms();
     });
 }
 
@@ -131,6 +162,14 @@ void OpenGLShader::PreProcess(const std::string& source)
 {
     AB_PROFILE_FUNCTION();
 
+    // Keyword defines have to come after #version
+    std::string defines;
+    for (uint32_t i = 0; i < m_KeywordNames.size(); i++)
+    {
+        if (m_Keywords & (1u << i))
+            defines += "#define " + m_KeywordNames[i] + "\n";
+    }
+
     const char* typeToken = "#type";
     size_t tokenLength = strlen(typeToken);
     size_t pos = source.find(typeToken, 0);
@@ -147,10 +186,18 @@ void OpenGLShader::PreProcess(const std::string& source)
         pos = source.find(typeToken, nextLinePos);
 
         auto shaderType = ShaderTypeFromString(type);
-        m_ShaderSource[shaderType] = pos == std::string::npos ?
+        auto& stageSource = m_ShaderSource[shaderType];
+        stageSource = pos == std::string::npos ?
             source.substr(nextLinePos) :
             source.substr(nextLinePos, pos - nextLinePos);
 
+        if (!defines.empty())
+        {
+            size_t version = stageSource.find("#version");
+            size_t insert = version != std::string::npos ? stageSource.find('\n', version) : std::string::npos;
+            stageSource.insert(insert != std::string::npos ? insert + 1 : 0, defines);
+        }
+
         if (shaderType == GL_COMPUTE_SHADER)
         {
             m_IsCompute = true;
@@ -253,6 +300,108 @@ static bool IsTypeStringResource(const std::string& type)
     return false;
 }
 
+// Uniform blocks open a brace before the statement ends
+static bool IsUniformBlock(const char* str)
+{
+    const char* brace = strstr(str, "{");
+    const char* semicolon = strstr(str, ";");
+    return brace && (!semicolon || brace < semicolon);
+}
+
+// "#pragma keywords ANIMATED ALBEDO_MAP=u_AlbedoTexture" declares keywords in bit order. Naming a texture
+// lets materials turn the keyword on by setting it, so such keywords must not change the material
+// blocks or the samplers a shader declares.
+void OpenGLShader::DeclareKeywords(const std::string& source)
+{
+    m_KeywordNames.clear();
+    m_KeywordTextures.clear();
+
+    const char* pragmaToken = "#pragma keywords";
+    size_t pos = source.find(pragmaToken);
+    while (pos != std::string::npos)
+    {
+        size_t begin = pos + strlen(pragmaToken);
+        size_t eol = source.find_first_of("\r\n", begin);
+        for (auto& token : Tokenize(source.substr(begin, eol - begin)))
+        {
+            auto equals = token.find("=");
+            std::string keyword = token.substr(0, equals);
+            if (std::find(m_KeywordNames.begin(), m_KeywordNames.end(), keyword) == m_KeywordNames.end())
+                m_KeywordNames.push_back(keyword);
+
+            if (equals != std::string::npos)
+                m_KeywordTextures[keyword] = token.substr(equals + 1);
+        }
+
+        pos = source.find(pragmaToken, begin);
+    }
+
+    AB_CORE_ASSERT(m_KeywordNames.size() <= 32, "Shaders support at most 32 keywords!");
+}
+
+// The parser doesn't run the preprocessor, so lines behind a keyword this variant leaves out are dropped
+// first. Only #ifdef and #ifndef on a declared keyword are evaluated, other conditionals are kept as they are.
+std::string OpenGLShader::StripDisabledKeywords(const std::string& source) const
+{
+    if (m_KeywordNames.empty())
+        return source;
+
+    struct Conditional
+    {
+        bool Keyword;
+        bool Enabled;
+    };
+    std::vector<Conditional> conditionals;
+
+    std::string result;
+    size_t pos = 0;
+    while (pos < source.size())
+    {
+        size_t eol = source.find('\n', pos);
+        size_t next = eol != std::string::npos ? eol + 1 : source.size();
+        std::string line = source.substr(pos, next - pos);
+        pos = next;
+
+        bool keep = true;
+        auto tokens = Tokenize(line);
+        if (!tokens.empty() && tokens[0][0] == '#')
+        {
+            const auto& directive = tokens[0];
+            uint32_t keyword = tokens.size() > 1 ? GetKeywordMask(tokens[1]) : 0;
+            if ((directive == "#ifdef" || directive == "#ifndef") && keyword)
+            {
+                bool defined = m_Keywords & keyword;
+                conditionals.push_back({ true, directive == "#ifdef" ? defined : !defined });
+                keep = false;
+            }
+            else if (StartsWith(directive, "#if"))
+            {
+                conditionals.push_back({ false, true });
+            }
+            else if ((directive == "#else" || directive == "#elif") && !conditionals.empty() && conditionals.back().Keyword)
+            {
+                AB_CORE_ASSERT(directive == "#else", "#elif is not supported after a keyword #ifdef!");
+                conditionals.back().Enabled = !conditionals.back().Enabled;
+                keep = false;
+            }
+            else if (directive == "#endif" && !conditionals.empty())
+            {
+                keep = !conditionals.back().Keyword;
+                conditionals.pop_back();
+            }
+        }
+
+        for (auto& conditional : conditionals)
+            keep = keep && conditional.Enabled;
+
+        if (keep)
+            result += line;
+    }
+
+    AB_CORE_ASSERT(conditionals.empty(), "Unterminated #if in shader!");
+    return result;
+}
+
 void OpenGLShader::Parse()
 {
     const char* token;
@@ -261,11 +410,13 @@ void OpenGLShader::Parse()
 
     m_Resources.clear();
     m_Structs.clear();
+    m_UniformTable.clear();
+    m_ResourceTable.clear();
     m_VSMaterialUniformBuffer.reset();
     m_PSMaterialUniformBuffer.reset();
 
-    auto& vertexSource = m_ShaderSource[GL_VERTEX_SHADER];
-    auto& fragmentSource = m_ShaderSource[GL_FRAGMENT_SHADER];
+    std::string vertexSource = StripDisabledKeywords(m_ShaderSource[GL_VERTEX_SHADER]);
+    std::string fragmentSource = StripDisabledKeywords(m_ShaderSource[GL_FRAGMENT_SHADER]);
 
     // Vertex Shader
     vstr = vertexSource.c_str();
@@ -274,7 +425,12 @@ void OpenGLShader::Parse()
 
     vstr = vertexSource.c_str();
     while (token = FindToken(vstr, "uniform"))
-        ParseUniform(GetStatement(token, &vstr), ShaderDomain::Vertex);
+    {
+        if (IsUniformBlock(token))
+            ParseUniformBlock(GetBlock(token, &vstr), ShaderDomain::Vertex);
+        else
+            ParseUniform(GetStatement(token, &vstr), ShaderDomain::Vertex);
+    }
 
     // Fragment Shader
     fstr = fragmentSource.c_str();
@@ -283,7 +439,29 @@ void OpenGLShader::Parse()
 
     fstr = fragmentSource.c_str();
     while (token = FindToken(fstr, "uniform"))
-        ParseUniform(GetStatement(token, &fstr), ShaderDomain::Pixel);
+    {
+        if (IsUniformBlock(token))
+            ParseUniformBlock(GetBlock(token, &fstr), ShaderDomain::Pixel);
+        else
+            ParseUniform(GetStatement(token, &fstr), ShaderDomain::Pixel);
+    }
+
+    // Registers follow declaration order, so every variant expects textures in the same units
+    uint32_t sampler = 0;
+    for (auto resource : m_Resources)
+    {
+        auto glResource = static_cast<OpenGLShaderResource*>(resource);
+        glResource->SetRegister(glResource->GetCount() == 1 ? sampler++ : 0);
+    }
+
+    for (auto& [keyword, texture] : m_KeywordTextures)
+    {
+        auto resource = static_cast<OpenGLShaderResource*>(FindResource(Hash::FNV(texture)));
+        if (resource)
+            resource->m_Keyword = GetKeywordMask(keyword);
+        else
+            AB_CORE_WARN("Keyword {0} in {1} names unknown texture {2}", keyword, m_Name, texture);
+    }
 }
 
 void OpenGLShader::ParseUniformStruct(const std::string& block, ShaderDomain domain)
@@ -323,6 +501,74 @@ void OpenGLShader::ParseUniformStruct(const std::string& block, ShaderDomain dom
     m_Structs.push_back(uniformStruct);
 }
 
+// Each stage declares its material values in one std140 block, which every material keeps its own copy of
+void OpenGLShader::ParseUniformBlock(const std::string& block, ShaderDomain domain)
+{
+    auto tokens = Tokenize(block);
+    uint32_t index = 0;
+
+    index++;    // uniform
+    std::string blockName = tokens[index++];
+    auto brace = blockName.find("{");
+    if (brace != std::string::npos)
+        blockName = blockName.substr(0, brace);
+    else
+        index++;    // {
+
+    auto& uniformBuffer = domain == ShaderDomain::Vertex ? m_VSMaterialUniformBuffer : m_PSMaterialUniformBuffer;
+    AB_CORE_ASSERT(!uniformBuffer, "Only one material block is supported per shader stage!");
+    uniformBuffer = CreateScope<OpenGLShaderUniformBuffer>(domain, blockName);
+
+    while (index + 1 < tokens.size())
+    {
+        if (tokens[index] == "}")
+            break;
+
+        std::string typeString = tokens[index++];
+        std::string name = tokens[index++];
+
+        auto semi = name.find(";");
+        if (semi != std::string::npos)
+            name = name.substr(0, semi);
+
+        uint32_t count = 1;
+        auto open = name.find("[");
+        if (open != std::string::npos)
+        {
+            auto close = name.find("]");
+            count = (uint32_t)atoi(name.substr(open + 1, close - open).c_str());
+            name = name.substr(0, open);
+        }
+
+        // Members of both blocks share one namespace once the program is linked
+        uint32_t nameHash = Hash::FNV(name);
+        auto existing = m_UniformTable.find(nameHash);
+        if (existing != m_UniformTable.end())
+        {
+            AB_CORE_ERROR("Uniform {0} clashes with {1} in the material blocks of {2}", name, existing->second->GetName(), m_Name);
+            AB_CORE_ASSERT(false, "Material uniform names have to be unique across shader stages!");
+        }
+
+        auto type = OpenGLShaderUniform::StringToType(typeString);
+        OpenGLShaderUniform* uniform = nullptr;
+
+        if (type == OpenGLShaderUniform::Type::None)
+        {
+            auto uniformStruct = FindStruct(typeString);
+            AB_CORE_ASSERT(uniformStruct, "Unknown uniform type!");
+            uniform = new OpenGLShaderUniform(domain, uniformStruct, name, count);
+        }
+        else
+        {
+            uniform = new OpenGLShaderUniform(domain, type, name, count);
+        }
+
+        uniform->m_Index = (uint32_t)m_UniformTable.size();
+        uniformBuffer->PushUniform(uniform);
+        m_UniformTable[nameHash] = uniform;
+    }
+}
+
 void OpenGLShader::ParseUniform(const std::string& statement, ShaderDomain domain)
 {
     auto tokens = Tokenize(statement);
@@ -345,51 +591,66 @@ void OpenGLShader::ParseUniform(const std::string& statement, ShaderDomain domai
     {
         ShaderResource* resource = new OpenGLShaderResource(OpenGLShaderResource::StringToType(typeString), name, count);
         m_Resources.push_back(resource);
-    }
-    else
-    {
-        auto type = OpenGLShaderUniform::StringToType(typeString);
-        OpenGLShaderUniform* uniform = nullptr;
-
-        if (type == OpenGLShaderUniform::Type::None)
-        {
-            auto uniformStruct = FindStruct(typeString);
-            uniform = new OpenGLShaderUniform(domain, uniformStruct, name, count);
-        }
-        else
-        {
-            uniform = new OpenGLShaderUniform(domain, type, name, count);
-        }
-
-        if (domain == ShaderDomain::Vertex)
-        {
-            if (!m_VSMaterialUniformBuffer)
-                m_VSMaterialUniformBuffer = CreateScope<OpenGLShaderUniformBuffer>(domain, m_Name + "_vertex");
 
-            m_VSMaterialUniformBuffer->PushUniform(uniform);
-        }
-        else if (domain == ShaderDomain::Pixel)
+        uint32_t nameHash = Hash::FNV(name);
+        if (m_ResourceTable.find(nameHash) != m_ResourceTable.end())
         {
-            if (!m_PSMaterialUniformBuffer)
-                m_PSMaterialUniformBuffer = CreateScope<OpenGLShaderUniformBuffer>(domain, m_Name + "_pixel");
-
-            m_PSMaterialUniformBuffer->PushUniform(uniform);
+            AB_CORE_ERROR("Resource {0} clashes with {1} in {2}", name, m_ResourceTable[nameHash]->GetName(), m_Name);
+            AB_CORE_ASSERT(false, "Resource names have to be unique!");
         }
+        m_ResourceTable[nameHash] = resource;
+    }
+    else
+    {
+        AB_CORE_WARN("Uniform {0} in {1} is outside the material block and cannot be set", name, m_Name);
     }
 }
 
 void OpenGLShader::CompileAndUploadShader()
 {
-    std::vector<RendererID> shaderIDs;
+    if (m_PendingProgram)
+        FinishCompile();
+
+    m_CachePath = OpenGLProgramCache::GetCachePath(m_Name, m_SourceHash);
+    if (!m_CachePath.empty())
+    {
+        m_PendingProgram = OpenGLProgramCache::Load(m_CachePath);
+        if (m_PendingProgram)
+            return;
+    }
 
     RendererID program = glCreateProgram();
+    if (!m_CachePath.empty())
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    // Attached shaders are only flagged for deletion, they go away once FinishCompile detaches them
     for (auto& [type, source] : m_ShaderSource)
     {
         const char* src = source.c_str();
         RendererID shader = glCreateShader(type);
         glShaderSource(shader, 1, &src, nullptr);
-
         glCompileShader(shader);
+
+        glAttachShader(program, shader);
+        glDeleteShader(shader);
+        m_PendingShaders.push_back(shader);
+    }
+
+    glLinkProgram(program);
+    m_PendingProgram = program;
+}
+
+void OpenGLShader::FinishCompile()
+{
+    AB_PROFILE_FUNCTION();
+
+    RendererID program = m_PendingProgram;
+    m_PendingProgram = 0;
+
+    // Status queries wait for the driver, the binary cache hands over programs without shaders
+    bool fromCache = m_PendingShaders.empty();
+    for (auto shader : m_PendingShaders)
+    {
         int32_t status;
         glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
         if (status == GL_FALSE)
@@ -400,18 +661,14 @@ void OpenGLShader::CompileAndUploadShader()
             std::vector<char> log(length);
             glGetShaderInfoLog(shader, length, &length, &log[0]);
 
-
-            glDeleteShader(shader);
-
             AB_CORE_ERROR("Shader failed to compile:\n{0}", log.data());
             AB_CORE_ASSERT(false);
         }
 
-        glAttachShader(program, shader);
-        shaderIDs.push_back(shader);
+        glDetachShader(program, shader);
     }
+    m_PendingShaders.clear();
 
-    glLinkProgram(program);
     int32_t status;
     glGetProgramiv(program, GL_LINK_STATUS, &status);
     if (status == GL_FALSE)
@@ -426,87 +683,44 @@ void OpenGLShader::CompileAndUploadShader()
         AB_CORE_ASSERT(false, "OpenGLShader program failed to link!");
 
         glDeleteProgram(program);
-        for (auto id : shaderIDs)
-        {
-            glDetachShader(program, id);
-            glDeleteShader(id);
-        }
+        return;
     }
-    else
-    {
-        for (auto id : shaderIDs)
-            glDetachShader(program, id);
 
-        m_RendererID = program;
-    }
+    if (m_RendererID)
+        glDeleteProgram(m_RendererID);
+    m_RendererID = program;
+
+    if (!fromCache && !m_CachePath.empty())
+        OpenGLProgramCache::Store(m_CachePath, program);
+
+    glUseProgram(m_RendererID);
+    if (!m_IsCompute)
+        ResolveUniforms();
+
+    m_Ready = true;
 }
 
 void OpenGLShader::ResolveUniforms()
 {
     if (m_VSMaterialUniformBuffer)
-    {
-        const auto& uniforms = m_VSMaterialUniformBuffer->GetUniforms();
-        for (uint32_t i = 0; i < uniforms.size(); i++)
-        {
-            auto uniform = dynamic_cast<OpenGLShaderUniform*>(uniforms[i]);
-            if (uniform->GetType() == OpenGLShaderUniform::Type::Struct)
-            {
-                const auto& uniformStruct = uniform->GetShaderUniformStruct();
-                const auto& fields = uniformStruct.GetFields();
-                for (uint32_t j = 0; j < fields.size(); j++)
-                {
-                    auto field = dynamic_cast<OpenGLShaderUniform*>(fields[j]);
-                    field->SetLocation(GetUniformLocation(uniform->GetName() + "." + field->GetName()));
-                }
-            }
-            else
-            {
-                uniform->SetLocation(GetUniformLocation(uniform->GetName()));
-            }
-        }
-    }
+        ResolveUniformBlock(m_VSMaterialUniformBuffer);
 
     if (m_PSMaterialUniformBuffer)
-    {
-        const auto& uniforms = m_PSMaterialUniformBuffer->GetUniforms();
-        for (uint32_t i = 0; i < uniforms.size(); i++)
-        {
-            auto uniform = dynamic_cast<OpenGLShaderUniform*>(uniforms[i]);
-            if (uniform->GetType() == OpenGLShaderUniform::Type::Struct)
-            {
-                const auto& uniformStruct = uniform->GetShaderUniformStruct();
-                const auto& fields = uniformStruct.GetFields();
-                for (uint32_t j = 0; j < fields.size(); j++)
-                {
-                    auto field = dynamic_cast<OpenGLShaderUniform*>(fields[j]);
-                    field->SetLocation(GetUniformLocation(uniform->GetName() + "." + field->GetName()));
-                }
-            }
-            else
-            {
-                uniform->SetLocation(GetUniformLocation(uniform->GetName()));
-            }
-        }
-    }
+        ResolveUniformBlock(m_PSMaterialUniformBuffer);
 
-    uint32_t sampler = 0;
-    for (uint32_t i = 0; i < m_Resources.size(); i++)
+    // Samplers a variant compiles out are inactive and have no location
+    for (auto resource : m_Resources)
     {
-        auto resource = dynamic_cast<OpenGLShaderResource*>(m_Resources[i]);
-        int32_t location = GetUniformLocation(resource->GetName());
+        int32_t location = glGetUniformLocation(m_RendererID, resource->GetName().c_str());
+        if (location == -1)
+            continue;
 
         if (resource->GetCount() == 1)
         {
-            resource->SetRegister(sampler);
-            if (location != -1)
-                UploadUniformInt(location, sampler);
-
-            sampler++;
+            UploadUniformInt(location, resource->GetRegister());
         }
         else
         {
-            resource->SetRegister(0);
-
             uint32_t count = resource->GetCount();
             int32_t* samplers = new int32_t[count];
             for (uint32_t j = 0; j < count; j++)
@@ -518,126 +732,40 @@ void OpenGLShader::ResolveUniforms()
     }
 }
 
-void OpenGLShader::ResolveAndSetUniforms(const Scope<OpenGLShaderUniformBuffer>& uniformBuffer, Buffer buffer)
-{
-    const auto& uniforms = uniformBuffer->GetUniforms();
-    for (uint32_t i = 0; i < uniforms.size(); i++)
-    {
-        auto uniform = dynamic_cast<OpenGLShaderUniform*>(uniforms[i]);
-        if (uniform->IsArray())
-            ResolveAndSetUniformArray(uniform, buffer);
-        else
-            ResolveAndSetUniform(uniform, buffer);
-    }
-}
-
-void OpenGLShader::ResolveAndSetUniform(OpenGLShaderUniform* uniform, Buffer buffer)
-{
-    if (uniform->GetLocation() == -1)
-    {
-        AB_CORE_ERROR("Uniform {0} has invalid location", uniform->GetName());
-        return;
-    }
-
-    uint32_t offset = uniform->GetOffset();
-    switch (uniform->GetType())
-    {
-        case OpenGLShaderUniform::Type::Int32:
-            UploadUniformInt(uniform->GetLocation(), *(int32_t*)&buffer.Data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Float32:
-            UploadUniformFloat(uniform->GetLocation(), *(float*)&buffer.Data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Vec2:
-            UploadUniformFloat2(uniform->GetLocation(), *(glm::vec2*)&buffer.Data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Vec3:
-            UploadUniformFloat3(uniform->GetLocation(), *(glm::vec3*)&buffer.Data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Vec4:
-            UploadUniformFloat4(uniform->GetLocation(), *(glm::vec4*)&buffer.Data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Mat3:
-            UploadUniformMat3(uniform->GetLocation(), *(glm::mat3*)&buffer.Data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Mat4:
-            UploadUniformMat4(uniform->GetLocation(), *(glm::mat4*)&buffer.Data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Struct:
-            UploadUniformStruct(uniform, buffer.Data, offset);
-            break;
-        default:
-            AB_CORE_ASSERT(false, "Unknown uniform type!");
-    }
-}
-
-void OpenGLShader::ResolveAndSetUniformArray(OpenGLShaderUniform* uniform, Buffer buffer)
+void OpenGLShader::ResolveUniformBlock(const Scope<OpenGLShaderUniformBuffer>& uniformBuffer)
 {
-    if (uniform->GetLocation() == -1)
+    uint32_t blockIndex = glGetUniformBlockIndex(m_RendererID, uniformBuffer->GetName().c_str());
+    if (blockIndex == GL_INVALID_INDEX)
     {
-        AB_CORE_ERROR("Uniform {0} has invalid location", uniform->GetName());
+        AB_CORE_WARN("Could not find uniform block {0} in shader.", uniformBuffer->GetName());
         return;
     }
 
-    uint32_t offset = uniform->GetOffset();
-    switch (uniform->GetType())
-    {
-        case OpenGLShaderUniform::Type::Int32:
-            UploadUniformIntArray(uniform->GetLocation(), (int32_t*)&buffer.Data[offset], uniform->GetCount());
-            break;
-        case OpenGLShaderUniform::Type::Mat4:
-            UploadUniformMat4Array(uniform->GetLocation(), *(glm::mat4*)&buffer.Data[offset], uniform->GetCount());
-            break;
-        default:
-            AB_CORE_ASSERT(false, "Unknown uniform type!");
-    }
-}
-
-void OpenGLShader::ResolveAndSetUniformField(const OpenGLShaderUniform& field, byte* data, uint32_t offset)
-{
-    if (field.GetLocation() == -1)
-    {
-        AB_CORE_ERROR("Uniform {0} has invalid location", field.GetName());
-        return;
-    }
+    glUniformBlockBinding(m_RendererID, blockIndex, uniformBuffer->GetRegister());
 
-    switch (field.GetType())
+    // The block is copied as it is laid out on the CPU, so the driver has to agree on where everything lives
+    for (auto uniform : uniformBuffer->GetUniforms())
     {
-        case OpenGLShaderUniform::Type::Int32:
-            UploadUniformInt(field.GetLocation(), *(int32_t*)&data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Float32:
-            UploadUniformFloat(field.GetLocation(), *(float*)&data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Vec2:
-            UploadUniformFloat2(field.GetLocation(), *(glm::vec2*)&data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Vec3:
-            UploadUniformFloat3(field.GetLocation(), *(glm::vec3*)&data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Vec4:
-            UploadUniformFloat4(field.GetLocation(), *(glm::vec4*)&data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Mat3:
-            UploadUniformMat3(field.GetLocation(), *(glm::mat3*)&data[offset]);
-            break;
-        case OpenGLShaderUniform::Type::Mat4:
-            UploadUniformMat4(field.GetLocation(), *(glm::mat4*)&data[offset]);
-            break;
-        default:
-            AB_CORE_ASSERT(false, "Unknown uniform type!");
+        auto glUniform = static_cast<OpenGLShaderUniform*>(uniform);
+        if (glUniform->GetType() == OpenGLShaderUniform::Type::Struct)
+            continue;
+
+        std::string name = glUniform->IsArray() ? glUniform->GetName() + "[0]" : glUniform->GetName();
+        uint32_t index = glGetProgramResourceIndex(m_RendererID, GL_UNIFORM, name.c_str());
+        if (index == GL_INVALID_INDEX)
+            continue;
+
+        GLenum property = GL_OFFSET;
+        int32_t offset = -1;
+        glGetProgramResourceiv(m_RendererID, GL_UNIFORM, index, 1, &property, 1, nullptr, &offset);
+        if (offset != (int32_t)glUniform->GetOffset())
+        {
+            AB_CORE_ERROR("Uniform {0} is at offset {1} in {2}, expected {3}", glUniform->GetName(), offset, m_Name, glUniform->GetOffset());
+            AB_CORE_ASSERT(false, "Material block layout mismatch!");
+        }
     }
 }
 
-int32_t OpenGLShader::GetUniformLocation(const std::string& name) const
-{
-    int32_t result = glGetUniformLocation(m_RendererID, name.c_str());
-    if (result == -1)
-        AB_CORE_WARN("Could not find uniform {0} in shader.", name);
-
-    return result;
-}
-
 ShaderUniformStruct* OpenGLShader::FindStruct(const std::string& name)
 {
     for (auto uniformStruct : m_Structs)
@@ -648,99 +776,139 @@ ShaderUniformStruct* OpenGLShader::FindStruct(const std::string& name)
     return nullptr;
 }
 
-void OpenGLShader::UploadUniformInt(uint32_t location, int32_t value)
+ShaderUniform* OpenGLShader::FindUniform(uint32_t nameHash) const
 {
-    glUniform1i(location, value);
+    auto it = m_UniformTable.find(nameHash);
+    return it != m_UniformTable.end() ? it->second : nullptr;
 }
 
-void OpenGLShader::UploadUniformIntArray(uint32_t location, int32_t* values, uint32_t count)
+ShaderResource* OpenGLShader::FindResource(uint32_t nameHash) const
 {
-    glUniform1iv(location, count, values);
+    auto it = m_ResourceTable.find(nameHash);
+    return it != m_ResourceTable.end() ? it->second : nullptr;
 }
 
-void OpenGLShader::UploadUniformFloat(uint32_t location, float value)
+Ref<Shader> OpenGLShader::GetVariant(uint32_t keywords) const
 {
-    glUniform1f(location, value);
-}
+    if (keywords == m_Keywords)
+        return const_cast<OpenGLShader*>(this);
 
-void OpenGLShader::UploadUniformFloat2(uint32_t location, const glm::vec2& value)
-{
-    glUniform2f(location, value.x, value.y);
-}
+    auto& variant = m_Variants[keywords];
+    if (!variant)
+    {
+        AB_CORE_ASSERT(((uint64_t)keywords >> m_KeywordNames.size()) == 0, "Shader does not declare these keywords!");
+        auto glVariant = Ref<OpenGLShader>::Create(*this, keywords);
+        AB_CORE_ASSERT(HasSameLayout(*glVariant), "Shader variants cannot change the material layout!");
+        variant = glVariant;
+    }
 
-void OpenGLShader::UploadUniformFloat3(uint32_t location, const glm::vec3& value)
-{
-    glUniform3f(location, value.x, value.y, value.z);
+    return variant;
 }
 
-void OpenGLShader::UploadUniformFloat4(uint32_t location, const glm::vec4& value)
+// Parsing is done on the calling thread, so the layout can be compared before the variant is ever bound
+bool OpenGLShader::HasSameLayout(const OpenGLShader& other) const
 {
-    glUniform4f(location, value.x, value.y, value.z, value.w);
-}
+    auto sameBlock = [&](const Scope<OpenGLShaderUniformBuffer>& block, const Scope<OpenGLShaderUniformBuffer>& otherBlock) {
+        if (!block || !otherBlock)
+            return !block && !otherBlock;
 
-void OpenGLShader::UploadUniformMat3(uint32_t location, const glm::mat3& value)
-{
-    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        const auto& uniforms = block->GetUniforms();
+        const auto& otherUniforms = otherBlock->GetUniforms();
+        if (block->GetSize() != otherBlock->GetSize() || uniforms.size() != otherUniforms.size())
+            return false;
+
+        for (size_t i = 0; i < uniforms.size(); i++)
+        {
+            if (uniforms[i]->GetName() != otherUniforms[i]->GetName() || uniforms[i]->GetOffset() != otherUniforms[i]->GetOffset())
+            {
+                AB_CORE_ERROR("Uniform {0} in {1} does not match {2} in {3}", uniforms[i]->GetName(), m_Name, otherUniforms[i]->GetName(), other.m_Name);
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (!sameBlock(m_VSMaterialUniformBuffer, other.m_VSMaterialUniformBuffer) || !sameBlock(m_PSMaterialUniformBuffer, other.m_PSMaterialUniformBuffer))
+        return false;
+
+    if (m_Resources.size() != other.m_Resources.size())
+        return false;
+
+    for (size_t i = 0; i < m_Resources.size(); i++)
+    {
+        if (m_Resources[i]->GetName() != other.m_Resources[i]->GetName() || m_Resources[i]->GetRegister() != other.m_Resources[i]->GetRegister())
+        {
+            AB_CORE_ERROR("Texture {0} in {1} does not match {2} in {3}", m_Resources[i]->GetName(), m_Name, other.m_Resources[i]->GetName(), other.m_Name);
+            return false;
+        }
+    }
+
+    return true;
 }
 
-void OpenGLShader::UploadUniformMat4(uint32_t location, const glm::mat4& value)
+uint32_t OpenGLShader::GetKeywordMask(const std::string& keyword) const
 {
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    for (uint32_t i = 0; i < m_KeywordNames.size(); i++)
+    {
+        if (m_KeywordNames[i] == keyword)
+            return 1u << i;
+    }
+    return 0;
 }
 
-void OpenGLShader::UploadUniformMat4Array(uint32_t location, const glm::mat4& value, uint32_t count)
+void OpenGLShader::UploadUniformInt(uint32_t location, int32_t value)
 {
-    glUniformMatrix4fv(location, count, GL_FALSE, glm::value_ptr(value));
+    glUniform1i(location, value);
 }
 
-void OpenGLShader::UploadUniformStruct(OpenGLShaderUniform* uniform, byte* buffer, uint32_t offset)
+void OpenGLShader::UploadUniformIntArray(uint32_t location, int32_t* values, uint32_t count)
 {
-    const auto& uniformStruct = uniform->GetShaderUniformStruct();
-    const auto& fields = uniformStruct.GetFields();
-    for (uint32_t i = 0; i < fields.size(); i++)
-    {
-        auto field = dynamic_cast<OpenGLShaderUniform*>(fields[i]);
-        ResolveAndSetUniformField(*field, buffer, offset);
-        offset += field->GetSize();
-    }
+    glUniform1iv(location, count, values);
 }
 
 void OpenGLShader::Bind() const
 {
-    Ref<const OpenGLShader> instance = this;
-    RenderCommand::Submit([instance]() {
+    Ref<OpenGLShader> instance = const_cast<OpenGLShader*>(this);
+    RenderCommand::Submit([instance]() mutable {
         AB_PROFILE_FUNCTION();
 
+        if (instance->m_PendingProgram)
+            instance->FinishCompile();
+
         glUseProgram(instance->m_RendererID);
     });
 }
 
-void OpenGLShader::Unbind() const
+bool OpenGLShader::IsReady() const
 {
-    RenderCommand::Submit([]() {
-        AB_PROFILE_FUNCTION();
+    if (m_Ready || !RendererAPI::GetCapabilities().HasExtension("GL_KHR_parallel_shader_compile"))
+        return true;
 
-        glUseProgram(0);
-    });
-}
-
-void OpenGLShader::SetVSMaterialUniformBuffer(const Buffer& buffer)
-{
-    RenderCommand::Submit([this, buffer] {
-        AB_PROFILE_FUNCTION();
+    // The status is polled on the render thread, so a finished compile is seen by a later draw
+    if (!m_ReadyQueryPending.exchange(true))
+    {
+        Ref<OpenGLShader> instance = const_cast<OpenGLShader*>(this);
+        RenderCommand::Submit([instance]() mutable {
+            instance->m_ReadyQueryPending = false;
+            if (!instance->m_PendingProgram)
+                return;
+
+            int32_t complete = GL_FALSE;
+            glGetProgramiv(instance->m_PendingProgram, GL_COMPLETION_STATUS_KHR, &complete);
+            if (complete)
+                instance->FinishCompile();
+        });
+    }
 
-        glUseProgram(m_RendererID);
-        ResolveAndSetUniforms(m_VSMaterialUniformBuffer, buffer);
-    });
+    return false;
 }
 
-void OpenGLShader::SetPSMaterialUniformBuffer(const Buffer& buffer)
+void OpenGLShader::Unbind() const
 {
-    RenderCommand::Submit([this, buffer] {
+    RenderCommand::Submit([]() {
         AB_PROFILE_FUNCTION();
-        
-        glUseProgram(m_RendererID);
-        ResolveAndSetUniforms(m_PSMaterialUniformBuffer, buffer);
+
+        glUseProgram(0);
     });
 }
 
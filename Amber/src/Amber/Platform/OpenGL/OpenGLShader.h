@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -20,10 +22,12 @@ class OpenGLShader : public Shader
 public:
     OpenGLShader(const std::string& filepath, ShaderType type = ShaderType::None);
     OpenGLShader(const std::string& name, const std::string& source);
+    OpenGLShader(const OpenGLShader& base, uint32_t keywords);
     ~OpenGLShader();
 
     void Bind() const override;
     void Unbind() const override;
+    bool IsReady() const override;
 
     const std::string& GetName() const override { return m_Name; }
     ShaderType GetType() const override { return m_Type; }
@@ -35,56 +39,71 @@ public:
     const ShaderUniformBuffer& GetVSMaterialUniformBuffer() const override { return *m_VSMaterialUniformBuffer; }
     const ShaderUniformBuffer& GetPSMaterialUniformBuffer() const override { return *m_PSMaterialUniformBuffer; }
 
-    void SetVSMaterialUniformBuffer(const Buffer& buffer) override;
-    void SetPSMaterialUniformBuffer(const Buffer& buffer) override;
-
     const ShaderResourceList& GetResources() const override { return m_Resources; }
 
+    ShaderUniform* FindUniform(uint32_t nameHash) const override;
+    ShaderResource* FindResource(uint32_t nameHash) const override;
+
+    Ref<Shader> GetVariant(uint32_t keywords) const override;
+    uint32_t GetKeywords() const override { return m_Keywords; }
+    uint32_t GetKeywordMask(const std::string& keyword) const override;
+
 private:
     std::unordered_map<std::string, int32_t> m_LocationMap;
     RendererID m_RendererID = 0;
     std::string m_Name, m_AssetPath;
     ShaderType m_Type;
     bool m_IsCompute = false;
+    uint64_t m_SourceHash = 0;
+    std::string m_CachePath;
+
+    // Declared keywords in bit order, and the texture that enables each one if any
+    std::vector<std::string> m_KeywordNames;
+    std::unordered_map<std::string, std::string> m_KeywordTextures;
+    uint32_t m_Keywords = 0;
+    std::string m_Source;
+    mutable std::unordered_map<uint32_t, Ref<Shader>> m_Variants;
+
+    // Compiled and linked but not yet checked, see FinishCompile
+    RendererID m_PendingProgram = 0;
+    std::vector<RendererID> m_PendingShaders;
+    // Set on the render thread, read when draws are recorded
+    std::atomic<bool> m_Ready = false;
+    mutable std::atomic<bool> m_ReadyQueryPending = false;
 
     Scope<OpenGLShaderUniformBuffer> m_VSMaterialUniformBuffer;
     Scope<OpenGLShaderUniformBuffer> m_PSMaterialUniformBuffer;
     ShaderResourceList m_Resources;
     ShaderUniformStructList m_Structs;
 
+    std::unordered_map<uint32_t, ShaderUniform*> m_UniformTable;
+    std::unordered_map<uint32_t, ShaderResource*> m_ResourceTable;
+
     std::unordered_map<GLenum, std::string> m_ShaderSource;
 
     void Load(const std::string& source);
-    void Reload();
 
     std::string ReadShaderFromFile() const;
+    void DeclareKeywords(const std::string& source);
     void PreProcess(const std::string& source);
+    std::string StripDisabledKeywords(const std::string& source) const;
     void Parse();
     void ParseUniformStruct(const std::string& block, ShaderDomain domain);
+    void ParseUniformBlock(const std::string& block, ShaderDomain domain);
     void ParseUniform(const std::string& statement, ShaderDomain domain);
 
     void CompileAndUploadShader();
+    void FinishCompile();
+
+    bool HasSameLayout(const OpenGLShader& other) const;
 
     void ResolveUniforms();
-    void ResolveAndSetUniforms(const Scope<OpenGLShaderUniformBuffer>& uniformBuffer, Buffer buffer);
-    void ResolveAndSetUniform(OpenGLShaderUniform* uniform, Buffer buffer);
-    void ResolveAndSetUniformArray(OpenGLShaderUniform* uniform, Buffer buffer);
-    void ResolveAndSetUniformField(const OpenGLShaderUniform& field, byte* data, uint32_t offset);
+    void ResolveUniformBlock(const Scope<OpenGLShaderUniformBuffer>& uniformBuffer);
 
-    int32_t GetUniformLocation(const std::string& name) const;
     ShaderUniformStruct* FindStruct(const std::string& name);
 
     void UploadUniformInt(uint32_t location, int32_t value);
     void UploadUniformIntArray(uint32_t location, int32_t* values, uint32_t count);
-    void UploadUniformFloat(uint32_t location, float value);
-    void UploadUniformFloat2(uint32_t location, const glm::vec2& values);
-    void UploadUniformFloat3(uint32_t location, const glm::vec3& values);
-    void UploadUniformFloat4(uint32_t location, const glm::vec4& values);
-    void UploadUniformMat3(uint32_t location, const glm::mat3& matrix);
-    void UploadUniformMat4(uint32_t location, const glm::mat4& matrix);
-    void UploadUniformMat4Array(uint32_t location, const glm::mat4& matrix, uint32_t count);
-
-    void UploadUniformStruct(OpenGLShaderUniform* uniform, byte* buffer, uint32_t offset);
 
     static GLenum ShaderTypeFromString(const std::string& type);
 };
@@ -4,16 +4,89 @@
 namespace Amber
 {
 
+static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
 OpenGLShaderUniform::OpenGLShaderUniform(ShaderDomain domain, OpenGLShaderUniform::Type type, const std::string& name, uint32_t count)
     : m_Name(name), m_Size(SizeOfUniformType(type) * count), m_Count(count), m_Domain(domain),
         m_Type(type), m_Struct(nullptr)
 {
+    uint32_t size = SizeOfUniformType(type);
+    switch (type)
+    {
+        case OpenGLShaderUniform::Type::Int32:
+        case OpenGLShaderUniform::Type::Float32:
+        case OpenGLShaderUniform::Type::Vec2:
+            LayoutElements({ { 0, 0, size } }, size, size, size);
+            break;
+        case OpenGLShaderUniform::Type::Vec3:
+        case OpenGLShaderUniform::Type::Vec4:
+        case OpenGLShaderUniform::Type::Mat4:
+            LayoutElements({ { 0, 0, size } }, size, 16, size);
+            break;
+        case OpenGLShaderUniform::Type::Mat3:
+            // Columns are padded to vec4s
+            LayoutElements({ { 0, 0, 12 }, { 12, 16, 12 }, { 24, 32, 12 } }, size, 16, 48);
+            break;
+        default:
+            AB_CORE_ASSERT(false, "Unknown uniform type!");
+    }
 }
 
 OpenGLShaderUniform::OpenGLShaderUniform(ShaderDomain domain, ShaderUniformStruct* uniformStruct, const std::string& name, uint32_t count)
     : m_Name(name), m_Size(uniformStruct->GetSize() * count), m_Count(count), m_Domain(domain),
         m_Type(OpenGLShaderUniform::Type::Struct), m_Struct(uniformStruct)
 {
+    std::vector<ShaderUniformSpan> elementSpans;
+    uint32_t blockOffset = 0;
+    uint32_t sourceOffset = 0;
+    for (auto field : uniformStruct->GetFields())
+    {
+        auto glField = static_cast<OpenGLShaderUniform*>(field);
+        blockOffset = AlignUp(blockOffset, glField->m_Alignment);
+        for (const auto& span : glField->m_Spans)
+            elementSpans.push_back({ sourceOffset + span.SourceOffset, blockOffset + span.BlockOffset, span.Size });
+
+        sourceOffset += glField->m_Size;
+        blockOffset += glField->m_BlockSize;
+    }
+
+    LayoutElements(elementSpans, uniformStruct->GetSize(), 16, AlignUp(blockOffset, 16));
+}
+
+void OpenGLShaderUniform::LayoutElements(const std::vector<ShaderUniformSpan>& elementSpans, uint32_t elementSize, uint32_t alignment, uint32_t blockElementSize)
+{
+    // Array elements start on a vec4 boundary
+    uint32_t stride = blockElementSize;
+    if (m_Count > 1)
+    {
+        alignment = 16;
+        stride = AlignUp(blockElementSize, 16);
+    }
+
+    m_Alignment = alignment;
+    m_BlockSize = stride * m_Count;
+
+    m_Spans.clear();
+    for (uint32_t i = 0; i < m_Count; i++)
+    {
+        for (const auto& elementSpan : elementSpans)
+        {
+            ShaderUniformSpan span = { i * elementSize + elementSpan.SourceOffset, i * stride + elementSpan.BlockOffset, elementSpan.Size };
+            if (!m_Spans.empty())
+            {
+                auto& last = m_Spans.back();
+                if (last.SourceOffset + last.Size == span.SourceOffset && last.BlockOffset + last.Size == span.BlockOffset)
+                {
+                    last.Size += span.Size;
+                    continue;
+                }
+            }
+            m_Spans.push_back(span);
+        }
+    }
 }
 
 uint32_t OpenGLShaderUniform::SizeOfUniformType(OpenGLShaderUniform::Type type)
@@ -72,6 +145,13 @@ void OpenGLShaderUniform::SetOffset(uint32_t offset)
 OpenGLShaderUniformBuffer::OpenGLShaderUniformBuffer(ShaderDomain domain, const std::string& name)
     : m_Name(name), m_Domain(domain)
 {
+    // Every material block has its own binding, so vertex and pixel blocks can stay bound together
+    m_Register = domain == ShaderDomain::Vertex ? 0 : 1;
+}
+
+uint32_t OpenGLShaderUniformBuffer::GetSize() const
+{
+    return AlignUp(m_Size, 16);
 }
 
 ShaderUniform* OpenGLShaderUniformBuffer::FindUniform(const std::string& name)
@@ -86,14 +166,10 @@ ShaderUniform* OpenGLShaderUniformBuffer::FindUniform(const std::string& name)
 
 void OpenGLShaderUniformBuffer::PushUniform(ShaderUniform* uniform)
 {
-    uint32_t offset = 0;
-    if (!m_Uniforms.empty())
-    {
-        auto prev = dynamic_cast<OpenGLShaderUniform*>(m_Uniforms.back());
-        offset = prev->GetOffset() + prev->GetSize();
-    }
-    dynamic_cast<OpenGLShaderUniform*>(uniform)->SetOffset(offset);
-    m_Size += uniform->GetSize();
+    auto glUniform = static_cast<OpenGLShaderUniform*>(uniform);
+    uint32_t offset = AlignUp(m_Size, glUniform->GetAlignment());
+    glUniform->SetOffset(offset);
+    m_Size = offset + glUniform->GetBlockSize();
 
     m_Uniforms.push_back(uniform);
 }
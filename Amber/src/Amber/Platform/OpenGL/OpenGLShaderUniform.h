@@ -28,11 +28,16 @@ public:
     uint32_t GetCount() const override { return m_Count; }
     uint32_t GetOffset() const override { return m_Offset; }
     ShaderDomain GetDomain() const override { return m_Domain; }
+    const std::vector<ShaderUniformSpan>& GetSpans() const override { return m_Spans; }
+    uint32_t GetIndex() const override { return m_Index; }
 
     uint32_t GetAbsoluteOffset() const { return m_Struct ? m_Struct->GetOffset() + m_Offset : m_Offset; }
     Type GetType() const { return m_Type; }
     const ShaderUniformStruct& GetShaderUniformStruct() const { AB_CORE_ASSERT(m_Struct); return *m_Struct; }
-    int32_t GetLocation() const { return m_Location; }
+
+    // std140 base alignment and padded size
+    uint32_t GetAlignment() const { return m_Alignment; }
+    uint32_t GetBlockSize() const { return m_BlockSize; }
 
     bool IsArray() const { return m_Count > 1; }
 
@@ -48,13 +53,17 @@ private:
     uint32_t m_Size;
     uint32_t m_Count;
     uint32_t m_Offset = 0;
+    uint32_t m_Index = 0;
     ShaderDomain m_Domain;
 
     Type m_Type;
     ShaderUniformStruct* m_Struct;
-    mutable int32_t m_Location = 0;
 
-    void SetLocation(int32_t location) { m_Location = location; }
+    uint32_t m_Alignment = 4;
+    uint32_t m_BlockSize = 0;
+    std::vector<ShaderUniformSpan> m_Spans;
+
+    void LayoutElements(const std::vector<ShaderUniformSpan>& elementSpans, uint32_t elementSize, uint32_t alignment, uint32_t blockElementSize);
 
     friend class OpenGLShader;
     friend class OpenGLShaderUniformBuffer;
@@ -71,7 +80,7 @@ public:
     const std::string& GetName() const override { return m_Name; }
     const ShaderUniformList& GetUniforms() const override { return m_Uniforms; }
     uint32_t GetRegister() const override { return m_Register; }
-    uint32_t GetSize() const override { return m_Size; }
+    uint32_t GetSize() const override;
     ShaderDomain GetDomain() const override { return m_Domain; }
 
 private:
@@ -95,6 +104,7 @@ public:
     const std::string& GetName() const override { return m_Name; }
     uint32_t GetRegister() const override { return m_Register; }
     uint32_t GetCount() const override { return m_Count; }
+    uint32_t GetKeyword() const override { return m_Keyword; }
 
     Type GetType() const { return m_Type; }
 
@@ -108,6 +118,7 @@ private:
     std::string m_Name;
     uint32_t m_Register = 0;
     uint32_t m_Count;
+    uint32_t m_Keyword = 0;
 
     Type m_Type;
 
@@ -0,0 +1,60 @@
+#include "abpch.h"
+#include "OpenGLStorageBuffer.h"
+
+#include <glad/glad.h>
+
+#include "Amber/Core/Buffer.h"
+
+#include "Amber/Renderer/RenderCommand.h"
+
+namespace Amber
+{
+
+OpenGLStorageBuffer::OpenGLStorageBuffer(size_t size)
+    : m_Size(size)
+{
+    Ref<OpenGLStorageBuffer> instance = this;
+    RenderCommand::Submit([instance]() mutable {
+        AB_PROFILE_FUNCTION();
+
+        glCreateBuffers(1, &instance->m_RendererID);
+        glNamedBufferData(instance->m_RendererID, instance->m_Size, nullptr, GL_DYNAMIC_DRAW);
+    });
+}
+
+OpenGLStorageBuffer::~OpenGLStorageBuffer()
+{
+    RendererID rendererID = m_RendererID;
+    RenderCommand::Submit([rendererID]() {
+        AB_PROFILE_FUNCTION();
+
+        glDeleteBuffers(1, &rendererID);
+    });
+}
+
+void OpenGLStorageBuffer::Bind(uint32_t binding) const
+{
+    Ref<const OpenGLStorageBuffer> instance = this;
+    RenderCommand::Submit([instance, binding]() {
+        AB_PROFILE_FUNCTION();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, instance->m_RendererID);
+    });
+}
+
+void OpenGLStorageBuffer::SetData(const void* buffer, size_t size, uint32_t offset)
+{
+    AB_PROFILE_FUNCTION();
+
+    AB_CORE_ASSERT(offset + size <= m_Size, "Storage buffer write out of range!");
+
+    const void* data = RenderCommand::CopyPayload(buffer, size);
+    Ref<OpenGLStorageBuffer> instance = this;
+    RenderCommand::Submit([instance, data, size, offset]() {
+        AB_PROFILE_FUNCTION();
+
+        glNamedBufferSubData(instance->m_RendererID, offset, size, data);
+    });
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Amber/Core/Base.h"
+
+#include "Amber/Renderer/StorageBuffer.h"
+
+namespace Amber
+{
+
+class OpenGLStorageBuffer : public StorageBuffer
+{
+public:
+    OpenGLStorageBuffer(size_t size);
+    ~OpenGLStorageBuffer();
+
+    void Bind(uint32_t binding) const override;
+
+    void SetData(const void* buffer, size_t size, uint32_t offset = 0) override;
+
+    size_t GetSize() const override { return m_Size; }
+    RendererID GetRendererID() const override { return m_RendererID; }
+
+private:
+    RendererID m_RendererID = 0;
+    size_t m_Size;
+};
+
+}
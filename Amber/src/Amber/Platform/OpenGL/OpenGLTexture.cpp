@@ -5,6 +5,11 @@
 
 #include "Amber/Renderer/RenderCommand.h"
 
+#ifndef GL_TEXTURE_SRGB_DECODE_EXT
+#define GL_TEXTURE_SRGB_DECODE_EXT 0x8A48
+#define GL_SKIP_DECODE_EXT 0x8A4A
+#endif
+
 namespace Amber
 {
 
@@ -16,7 +21,10 @@ static GLenum AmberToOpenGLTextureFormat(TextureFormat format)
         case TextureFormat::RG:             return GL_RG;
         case TextureFormat::RGB:            return GL_RGB;
         case TextureFormat::RGBA:           return GL_RGBA;
+        case TextureFormat::SRGBA:          return GL_RGBA;
         case TextureFormat::Float16:        return GL_RGB;
+        case TextureFormat::R11G11B10F:     return GL_RGB;
+        case TextureFormat::Depth:          return GL_DEPTH_COMPONENT;
         case TextureFormat::DepthStencil:   return GL_DEPTH_STENCIL;
     }
 
@@ -32,7 +40,10 @@ static GLint AmberToOpenGLInternalTextureFormat(TextureFormat format, bool srgb
         case TextureFormat::RG:             return GL_RG8;
         case TextureFormat::RGB:            return srgb ? GL_SRGB8 : GL_RGB8;
         case TextureFormat::RGBA:           return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+        case TextureFormat::SRGBA:          return GL_SRGB8_ALPHA8;
         case TextureFormat::Float16:        return GL_RGBA16F;
+        case TextureFormat::R11G11B10F:     return GL_R11F_G11F_B10F;
+        case TextureFormat::Depth:          return GL_DEPTH_COMPONENT32F;
         case TextureFormat::DepthStencil:   return GL_DEPTH24_STENCIL8;
     }
 
@@ -89,6 +100,10 @@ OpenGLTexture2D::OpenGLTexture2D(TextureFormat format, uint32_t width, uint32_t
             glTextureParameteri(instance->m_RendererID, GL_TEXTURE_WRAP_S, AmberToOpenGLTextureWrap(instance->m_Wrap));
             glTextureParameteri(instance->m_RendererID, GL_TEXTURE_WRAP_T, AmberToOpenGLTextureWrap(instance->m_Wrap));
 
+            // Render targets hold display-ready values, so samplers return them without conversion
+            if (instance->m_Format == TextureFormat::SRGBA && RendererAPI::GetCapabilities().HasExtension("GL_EXT_texture_sRGB_decode"))
+                glTextureParameteri(instance->m_RendererID, GL_TEXTURE_SRGB_DECODE_EXT, GL_SKIP_DECODE_EXT);
+
             glTextureStorage2D(
                 instance->m_RendererID, 1, AmberToOpenGLInternalTextureFormat(instance->m_Format), 
                 instance->m_Width, instance->m_Height);
@@ -103,7 +118,7 @@ OpenGLTexture2D::OpenGLTexture2D(const std::string& path, bool srgb, bool flip,
 {
     AB_PROFILE_FUNCTION();
 
-    stbi_set_flip_vertically_on_load(flip);
+    stbi_set_flip_vertically_on_load_thread(flip);
 
     int width, height, channels;
     {
@@ -244,9 +259,49 @@ OpenGLTextureCube::OpenGLTextureCube(TextureFormat format, uint32_t width, uint3
     });
 }
 
+OpenGLTextureCube::OpenGLTextureCube(TextureFormat format, uint32_t width, uint32_t height, Buffer data)
+    : m_Width(width), m_Height(height), m_Format(format), m_LocalData(std::move(data))
+{
+    Ref<OpenGLTextureCube> instance = this;
+    RenderCommand::Submit([instance]() mutable {
+        glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &instance->m_RendererID);
+
+        uint32_t levels = instance->GetMipLevelCount();
+
+        glTextureParameteri(instance->m_RendererID, GL_TEXTURE_MIN_FILTER, AmberToOpenGLTextureFilter(TextureFilter::Linear, levels > 1));
+        glTextureParameteri(instance->m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTextureParameteri(instance->m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(instance->m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(instance->m_RendererID, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+        glTextureStorage2D(
+            instance->m_RendererID, levels, AmberToOpenGLInternalTextureFormat(instance->m_Format),
+            instance->m_Width, instance->m_Height);
+
+        bool hdr = instance->m_Format == TextureFormat::Float16;
+        GLenum format = hdr ? GL_RGBA : AmberToOpenGLTextureFormat(instance->m_Format);
+        GLenum type = hdr ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        size_t offset = 0;
+        for (uint32_t level = 0; level < levels; level++)
+        {
+            uint32_t width = glm::max(instance->m_Width >> level, 1u);
+            uint32_t height = glm::max(instance->m_Height >> level, 1u);
+            glTextureSubImage3D(instance->m_RendererID, level, 0, 0, 0, width, height, 6, format, type, instance->m_LocalData.Data + offset);
+            offset += instance->GetLevelSize(level);
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        instance->m_LocalData.Clear();
+    });
+}
+
 OpenGLTextureCube::OpenGLTextureCube(const std::string& path)
 {
-    stbi_set_flip_vertically_on_load(false);
+    stbi_set_flip_vertically_on_load_thread(false);
 
     int width, height, channels;
     m_ImageData = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb);
@@ -352,4 +407,43 @@ void OpenGLTextureCube::Bind(uint32_t slot) const
     });
 }
 
+Buffer OpenGLTextureCube::GetData() const
+{
+    uint32_t levels = GetMipLevelCount();
+
+    size_t size = 0;
+    for (uint32_t level = 0; level < levels; level++)
+        size += GetLevelSize(level);
+
+    Buffer data;
+    data.Allocate(size);
+
+    bool hdr = m_Format == TextureFormat::Float16;
+    GLenum format = hdr ? GL_RGBA : AmberToOpenGLTextureFormat(m_Format);
+    GLenum type = hdr ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    size_t offset = 0;
+    for (uint32_t level = 0; level < levels; level++)
+    {
+        size_t levelSize = GetLevelSize(level);
+        glGetTextureImage(m_RendererID, level, format, type, (GLsizei)levelSize, data.Data + offset);
+        offset += levelSize;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    return data;
+}
+
+size_t OpenGLTextureCube::GetLevelSize(uint32_t level) const
+{
+    size_t width = glm::max(m_Width >> level, 1u);
+    size_t height = glm::max(m_Height >> level, 1u);
+    size_t bpp = m_Format == TextureFormat::Float16 ? 8 : Texture::GetBPP(m_Format);
+
+    return width * height * bpp * 6;
+}
+
 }
\ No newline at end of file
@@ -57,6 +57,7 @@ class OpenGLTextureCube : public TextureCube
 {
 public:
     OpenGLTextureCube(TextureFormat format, uint32_t width, uint32_t height);
+    OpenGLTextureCube(TextureFormat format, uint32_t width, uint32_t height, Buffer data);
     OpenGLTextureCube(const std::string& path);
     ~OpenGLTextureCube();
 
@@ -67,6 +68,7 @@ public:
     uint32_t GetHeight() const override { return m_Height; }
     TextureFormat GetFormat() const override { return m_Format; }
     uint32_t GetMipLevelCount() const override { return Texture::CalculateMipMapCount(m_Width, m_Height); }
+    Buffer GetData() const override;
 
     const std::string& GetAssetPath() const override { return m_AssetPath; }
 
@@ -75,6 +77,9 @@ public:
         return m_RendererID == ((OpenGLTextureCube&)other).m_RendererID;
     }
 
+private:
+    size_t GetLevelSize(uint32_t level) const;
+
 private:
     RendererID m_RendererID = 0;
 
@@ -82,6 +87,7 @@ private:
     uint32_t m_Width, m_Height;
     TextureFormat m_Format;
     byte* m_ImageData;
+    Buffer m_LocalData;
 };
 
 }
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Amber/Core/Base.h"
+
+#include "Amber/Renderer/UniformBuffer.h"
+
+namespace Amber
+{
+
+class OpenGLUniformBuffer : public UniformBuffer
+{
+public:
+    OpenGLUniformBuffer(size_t size);
+    ~OpenGLUniformBuffer();
+
+    void Bind(uint32_t binding) const override;
+
+    void SetData(const void* buffer, size_t size, uint32_t offset = 0) override;
+
+    size_t GetSize() const override { return m_Size; }
+    RendererID GetRendererID() const override { return m_RendererID; }
+
+private:
+    RendererID m_RendererID = 0;
+    size_t m_Size;
+};
+
+}
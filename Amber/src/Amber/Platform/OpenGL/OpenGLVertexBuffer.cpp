@@ -79,14 +79,14 @@ void OpenGLVertexBuffer::SetData(void* buffer, size_t size, uint32_t offset)
 {
     AB_PROFILE_FUNCTION();
 
-    m_LocalData = Buffer(buffer, size);
     m_Size = size;
     
+    const void* data = RenderCommand::CopyPayload(buffer, size);
     Ref<OpenGLVertexBuffer> instance = this;
-    RenderCommand::Submit([instance, offset]() {
+    RenderCommand::Submit([instance, data, size, offset]() {
         AB_PROFILE_FUNCTION();
         
-        glNamedBufferSubData(instance->m_RendererID, offset, instance->m_Size, instance->m_LocalData.Data);
+        glNamedBufferSubData(instance->m_RendererID, offset, size, data);
     });
 }
 
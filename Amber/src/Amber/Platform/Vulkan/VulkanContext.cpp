@@ -0,0 +1,434 @@
+#include "abpch.h"
+#include "VulkanContext.h"
+
+#include <GLFW/glfw3.h>
+
+#include "Amber/Core/Base.h"
+
+namespace Amber
+{
+
+VulkanContext* VulkanContext::s_Instance = nullptr;
+
+#ifdef AB_DEBUG
+static const char* s_ValidationLayer = "VK_LAYER_KHRONOS_validation";
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL VulkanMessageCallback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+    VkDebugUtilsMessageTypeFlagsEXT type,
+    const VkDebugUtilsMessengerCallbackDataEXT* data,
+    void* userData)
+{
+    switch (severity)
+    {
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:   AB_CORE_ERROR(data->pMessage); break;
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT: AB_CORE_WARN(data->pMessage); break;
+        default:                                              AB_CORE_TRACE(data->pMessage); break;
+    }
+    return VK_FALSE;
+}
+
+static bool HasValidationLayer()
+{
+    uint32_t layerCount = 0;
+    vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+    std::vector<VkLayerProperties> layers(layerCount);
+    vkEnumerateInstanceLayerProperties(&layerCount, layers.data());
+
+    for (const auto& layer : layers)
+    {
+        if (strcmp(layer.layerName, s_ValidationLayer) == 0)
+            return true;
+    }
+    return false;
+}
+#endif
+
+VulkanContext::VulkanContext(GLFWwindow* windowHandle)
+    : m_WindowHandle(windowHandle)
+{
+    AB_CORE_ASSERT(windowHandle, "Window handle is null!");
+    AB_CORE_ASSERT(!s_Instance, "Only one Vulkan context is supported!");
+    s_Instance = this;
+
+    Init();
+}
+
+VulkanContext::~VulkanContext()
+{
+    vkDeviceWaitIdle(m_Device);
+
+    for (auto& frame : m_Frames)
+    {
+        vkDestroyFence(m_Device, frame.InFlight, nullptr);
+        vkDestroySemaphore(m_Device, frame.ImageAvailable, nullptr);
+    }
+    vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+
+    DestroySwapchain();
+    vkDestroyDevice(m_Device, nullptr);
+    vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr);
+
+    if (m_DebugMessenger)
+    {
+        auto destroyMessenger = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(m_Instance, "vkDestroyDebugUtilsMessengerEXT");
+        destroyMessenger(m_Instance, m_DebugMessenger, nullptr);
+    }
+    vkDestroyInstance(m_Instance, nullptr);
+
+    s_Instance = nullptr;
+}
+
+void VulkanContext::Init()
+{
+    AB_CORE_ASSERT(glfwVulkanSupported(), "No Vulkan loader found!");
+
+    CreateInstance();
+    VulkanCheckResult(glfwCreateWindowSurface(m_Instance, m_WindowHandle, nullptr, &m_Surface));
+
+    PickPhysicalDevice();
+    CreateDevice();
+    CreateSwapchain();
+    CreateFrames();
+}
+
+void VulkanContext::CreateInstance()
+{
+    VkApplicationInfo appInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+    appInfo.pApplicationName = "Amber";
+    appInfo.pEngineName = "Amber";
+    appInfo.apiVersion = VK_API_VERSION_1_2;
+
+    uint32_t glfwExtensionCount = 0;
+    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    std::vector<const char*> layers;
+
+#ifdef AB_DEBUG
+    if (HasValidationLayer())
+    {
+        layers.push_back(s_ValidationLayer);
+        extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    }
+    else
+    {
+        AB_CORE_WARN("Vulkan validation layer not found, running without it");
+    }
+#endif
+
+    VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+    createInfo.pApplicationInfo = &appInfo;
+    createInfo.enabledExtensionCount = (uint32_t)extensions.size();
+    createInfo.ppEnabledExtensionNames = extensions.data();
+    createInfo.enabledLayerCount = (uint32_t)layers.size();
+    createInfo.ppEnabledLayerNames = layers.data();
+    VulkanCheckResult(vkCreateInstance(&createInfo, nullptr, &m_Instance));
+
+#ifdef AB_DEBUG
+    if (!layers.empty())
+    {
+        VkDebugUtilsMessengerCreateInfoEXT messengerInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
+        messengerInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        messengerInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+        messengerInfo.pfnUserCallback = VulkanMessageCallback;
+
+        auto createMessenger = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(m_Instance, "vkCreateDebugUtilsMessengerEXT");
+        if (createMessenger)
+            VulkanCheckResult(createMessenger(m_Instance, &messengerInfo, nullptr, &m_DebugMessenger));
+    }
+#endif
+}
+
+void VulkanContext::PickPhysicalDevice()
+{
+    uint32_t deviceCount = 0;
+    vkEnumeratePhysicalDevices(m_Instance, &deviceCount, nullptr);
+    AB_CORE_ASSERT(deviceCount > 0, "No Vulkan devices found!");
+    std::vector<VkPhysicalDevice> devices(deviceCount);
+    vkEnumeratePhysicalDevices(m_Instance, &deviceCount, devices.data());
+
+    // Discrete over integrated over anything else, so CPU implementations such as lavapipe are still picked when alone
+    int bestScore = -1;
+    for (auto device : devices)
+    {
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, families.data());
+
+        int family = -1;
+        for (uint32_t i = 0; i < familyCount; i++)
+        {
+            VkBool32 presentSupported = VK_FALSE;
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupported);
+            if ((families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) && presentSupported)
+            {
+                family = (int)i;
+                break;
+            }
+        }
+        if (family < 0)
+            continue;
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+
+        int score = 0;
+        if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
+            score = 2;
+        else if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU)
+            score = 1;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            m_PhysicalDevice = device;
+            m_GraphicsQueueFamily = (uint32_t)family;
+        }
+    }
+    AB_CORE_ASSERT(m_PhysicalDevice, "No Vulkan device can present to the window!");
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &properties);
+    AB_CORE_INFO("Vulkan Info:");
+    AB_CORE_INFO("  Device: {0}", properties.deviceName);
+    AB_CORE_INFO("  Version: {0}.{1}.{2}", VK_VERSION_MAJOR(properties.apiVersion), VK_VERSION_MINOR(properties.apiVersion), VK_VERSION_PATCH(properties.apiVersion));
+}
+
+void VulkanContext::CreateDevice()
+{
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+    queueInfo.queueFamilyIndex = m_GraphicsQueueFamily;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &priority;
+
+    const char* extensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+
+    VkDeviceCreateInfo createInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+    createInfo.queueCreateInfoCount = 1;
+    createInfo.pQueueCreateInfos = &queueInfo;
+    createInfo.enabledExtensionCount = 1;
+    createInfo.ppEnabledExtensionNames = extensions;
+    VulkanCheckResult(vkCreateDevice(m_PhysicalDevice, &createInfo, nullptr, &m_Device));
+
+    vkGetDeviceQueue(m_Device, m_GraphicsQueueFamily, 0, &m_GraphicsQueue);
+}
+
+void VulkanContext::CreateSwapchain()
+{
+    VkSurfaceCapabilitiesKHR capabilities;
+    vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_PhysicalDevice, m_Surface, &capabilities);
+    AB_CORE_ASSERT(capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT, "Swapchain images can't be cleared!");
+
+    uint32_t formatCount = 0;
+    vkGetPhysicalDeviceSurfaceFormatsKHR(m_PhysicalDevice, m_Surface, &formatCount, nullptr);
+    std::vector<VkSurfaceFormatKHR> formats(formatCount);
+    vkGetPhysicalDeviceSurfaceFormatsKHR(m_PhysicalDevice, m_Surface, &formatCount, formats.data());
+
+    VkSurfaceFormatKHR surfaceFormat = formats[0];
+    for (const auto& format : formats)
+    {
+        if (format.format == VK_FORMAT_B8G8R8A8_UNORM && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+        {
+            surfaceFormat = format;
+            break;
+        }
+    }
+
+    if (capabilities.currentExtent.width != UINT32_MAX)
+    {
+        m_SwapchainExtent = capabilities.currentExtent;
+    }
+    else
+    {
+        int width, height;
+        glfwGetFramebufferSize(m_WindowHandle, &width, &height);
+        m_SwapchainExtent.width = glm::clamp((uint32_t)width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        m_SwapchainExtent.height = glm::clamp((uint32_t)height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+
+    uint32_t imageCount = capabilities.minImageCount + 1;
+    if (capabilities.maxImageCount > 0)
+        imageCount = glm::min(imageCount, capabilities.maxImageCount);
+
+    VkSwapchainCreateInfoKHR createInfo = { VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR };
+    createInfo.surface = m_Surface;
+    createInfo.minImageCount = imageCount;
+    createInfo.imageFormat = surfaceFormat.format;
+    createInfo.imageColorSpace = surfaceFormat.colorSpace;
+    createInfo.imageExtent = m_SwapchainExtent;
+    createInfo.imageArrayLayers = 1;
+    createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.preTransform = capabilities.currentTransform;
+    createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    // FIFO is the only mode every implementation has to support
+    createInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    createInfo.clipped = VK_TRUE;
+    VulkanCheckResult(vkCreateSwapchainKHR(m_Device, &createInfo, nullptr, &m_Swapchain));
+    m_SwapchainFormat = surfaceFormat.format;
+
+    vkGetSwapchainImagesKHR(m_Device, m_Swapchain, &imageCount, nullptr);
+    m_SwapchainImages.resize(imageCount);
+    vkGetSwapchainImagesKHR(m_Device, m_Swapchain, &imageCount, m_SwapchainImages.data());
+
+    VkSemaphoreCreateInfo semaphoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    m_RenderFinished.resize(imageCount);
+    for (auto& semaphore : m_RenderFinished)
+        VulkanCheckResult(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &semaphore));
+}
+
+void VulkanContext::DestroySwapchain()
+{
+    for (auto semaphore : m_RenderFinished)
+        vkDestroySemaphore(m_Device, semaphore, nullptr);
+    m_RenderFinished.clear();
+    m_SwapchainImages.clear();
+
+    vkDestroySwapchainKHR(m_Device, m_Swapchain, nullptr);
+    m_Swapchain = VK_NULL_HANDLE;
+}
+
+void VulkanContext::CreateFrames()
+{
+    VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = m_GraphicsQueueFamily;
+    VulkanCheckResult(vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_CommandPool));
+
+    VkCommandBufferAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+    allocateInfo.commandPool = m_CommandPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+
+    VkSemaphoreCreateInfo semaphoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    VkFenceCreateInfo fenceInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for (auto& frame : m_Frames)
+    {
+        VulkanCheckResult(vkAllocateCommandBuffers(m_Device, &allocateInfo, &frame.CommandBuffer));
+        VulkanCheckResult(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &frame.ImageAvailable));
+        VulkanCheckResult(vkCreateFence(m_Device, &fenceInfo, nullptr, &frame.InFlight));
+    }
+}
+
+void VulkanContext::SwapBuffers()
+{
+    AB_PROFILE_FUNCTION();
+
+    int width, height;
+    glfwGetFramebufferSize(m_WindowHandle, &width, &height);
+    if (width == 0 || height == 0)
+        return;
+
+    Frame& frame = m_Frames[m_FrameIndex];
+    vkWaitForFences(m_Device, 1, &frame.InFlight, VK_TRUE, UINT64_MAX);
+
+    uint32_t imageIndex;
+    VkResult result = vkAcquireNextImageKHR(m_Device, m_Swapchain, UINT64_MAX, frame.ImageAvailable, VK_NULL_HANDLE, &imageIndex);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        vkDeviceWaitIdle(m_Device);
+        DestroySwapchain();
+        CreateSwapchain();
+        return;
+    }
+    AB_CORE_ASSERT(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR, "Failed to acquire a swapchain image!");
+    vkResetFences(m_Device, 1, &frame.InFlight);
+
+    VkImage image = m_SwapchainImages[imageIndex];
+    VkCommandBuffer commandBuffer = frame.CommandBuffer;
+    vkResetCommandBuffer(commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    VkImageMemoryBarrier barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = range;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkClearColorValue clearColor = { { m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a } };
+    vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    vkEndCommandBuffer(commandBuffer);
+
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &frame.ImageAvailable;
+    submitInfo.pWaitDstStageMask = &waitStage;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &m_RenderFinished[imageIndex];
+    VulkanCheckResult(vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, frame.InFlight));
+
+    VkPresentInfoKHR presentInfo = { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &m_RenderFinished[imageIndex];
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = &m_Swapchain;
+    presentInfo.pImageIndices = &imageIndex;
+    result = vkQueuePresentKHR(m_GraphicsQueue, &presentInfo);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    {
+        vkDeviceWaitIdle(m_Device);
+        DestroySwapchain();
+        CreateSwapchain();
+    }
+
+    m_FrameIndex = (m_FrameIndex + 1) % s_FramesInFlight;
+}
+
+uint32_t VulkanContext::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memoryProperties);
+
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+    {
+        if ((typeBits & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            return i;
+    }
+
+    AB_CORE_ASSERT(false, "No suitable Vulkan memory type!");
+    return 0;
+}
+
+void VulkanContext::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory) const
+{
+    VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VulkanCheckResult(vkCreateBuffer(m_Device, &bufferInfo, nullptr, &buffer));
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(m_Device, buffer, &requirements);
+
+    VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocateInfo.allocationSize = requirements.size;
+    allocateInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, properties);
+    VulkanCheckResult(vkAllocateMemory(m_Device, &allocateInfo, nullptr, &memory));
+    VulkanCheckResult(vkBindBufferMemory(m_Device, buffer, memory, 0));
+}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+
+#include "Amber/Renderer/GraphicsContext.h"
+
+struct GLFWwindow;
+
+namespace Amber
+{
+
+// The call is made in every configuration, only the check is compiled out with the asserts
+inline void VulkanCheckResult(VkResult result)
+{
+    if (result != VK_SUCCESS)
+    {
+        AB_CORE_ERROR("Vulkan call failed with VkResult {0}", (int)result);
+        AB_CORE_ASSERT(false, "Vulkan call failed!");
+    }
+}
+
+// Owns the instance, device and swapchain. Until the Vulkan render passes exist a frame only clears
+// the swapchain image to the clear color and presents it.
+class VulkanContext : public GraphicsContext
+{
+public:
+    VulkanContext(GLFWwindow* windowHandle);
+    ~VulkanContext();
+
+    void Init() override;
+    void SwapBuffers() override;
+
+    void SetClearColor(const glm::vec4& color) { m_ClearColor = color; }
+
+    VkInstance GetInstance() const { return m_Instance; }
+    VkPhysicalDevice GetPhysicalDevice() const { return m_PhysicalDevice; }
+    VkDevice GetDevice() const { return m_Device; }
+    VkQueue GetGraphicsQueue() const { return m_GraphicsQueue; }
+    uint32_t GetGraphicsQueueFamily() const { return m_GraphicsQueueFamily; }
+
+    // Index of a memory type allowed by typeBits that has all the requested properties
+    uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+    void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory) const;
+
+    static VulkanContext& Get() { return *s_Instance; }
+
+private:
+    static constexpr uint32_t s_FramesInFlight = 2;
+
+    struct Frame
+    {
+        VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+        VkSemaphore ImageAvailable = VK_NULL_HANDLE;
+        VkFence InFlight = VK_NULL_HANDLE;
+    };
+
+    GLFWwindow* m_WindowHandle;
+
+    VkInstance m_Instance = VK_NULL_HANDLE;
+    VkDebugUtilsMessengerEXT m_DebugMessenger = VK_NULL_HANDLE;
+    VkSurfaceKHR m_Surface = VK_NULL_HANDLE;
+    VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
+    uint32_t m_GraphicsQueueFamily = 0;
+
+    VkSwapchainKHR m_Swapchain = VK_NULL_HANDLE;
+    VkFormat m_SwapchainFormat = VK_FORMAT_UNDEFINED;
+    VkExtent2D m_SwapchainExtent = { 0, 0 };
+    std::vector<VkImage> m_SwapchainImages;
+    // Signalled by the submit that last wrote each image, so it is per image rather than per frame
+    std::vector<VkSemaphore> m_RenderFinished;
+
+    VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+    Frame m_Frames[s_FramesInFlight];
+    uint32_t m_FrameIndex = 0;
+
+    glm::vec4 m_ClearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    void CreateInstance();
+    void PickPhysicalDevice();
+    void CreateDevice();
+    void CreateSwapchain();
+    void DestroySwapchain();
+    void CreateFrames();
+
+    static VulkanContext* s_Instance;
+};
+
+}
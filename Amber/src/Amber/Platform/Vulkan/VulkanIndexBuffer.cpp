@@ -0,0 +1,50 @@
+#include "abpch.h"
+#include "VulkanIndexBuffer.h"
+
+#include "Amber/Platform/Vulkan/VulkanContext.h"
+
+#include "Amber/Renderer/RenderCommand.h"
+
+namespace Amber
+{
+
+VulkanIndexBuffer::VulkanIndexBuffer(void* data, size_t size)
+    : m_Size(size)
+{
+    auto& context = VulkanContext::Get();
+    context.CreateBuffer(size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_Buffer, m_Memory);
+    VulkanCheckResult(vkMapMemory(context.GetDevice(), m_Memory, 0, size, 0, &m_MappedData));
+    if (data)
+        memcpy(m_MappedData, data, size);
+}
+
+VulkanIndexBuffer::~VulkanIndexBuffer()
+{
+    VkBuffer buffer = m_Buffer;
+    VkDeviceMemory memory = m_Memory;
+    RenderCommand::Submit([buffer, memory]() {
+        AB_PROFILE_FUNCTION();
+
+        VkDevice device = VulkanContext::Get().GetDevice();
+        vkDestroyBuffer(device, buffer, nullptr);
+        vkFreeMemory(device, memory, nullptr);
+    });
+}
+
+void VulkanIndexBuffer::SetData(void* buffer, size_t size, uint32_t offset)
+{
+    AB_PROFILE_FUNCTION();
+
+    AB_CORE_ASSERT(offset + size <= m_Size, "Index buffer write out of range!");
+
+    const void* data = RenderCommand::CopyPayload(buffer, size);
+    Ref<VulkanIndexBuffer> instance = this;
+    RenderCommand::Submit([instance, data, size, offset]() {
+        AB_PROFILE_FUNCTION();
+
+        memcpy((uint8_t*)instance->m_MappedData + offset, data, size);
+    });
+}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Amber/Core/Base.h"
+
+#include "Amber/Renderer/IndexBuffer.h"
+
+namespace Amber
+{
+
+// Host visible and persistently mapped like VulkanVertexBuffer
+class VulkanIndexBuffer : public IndexBuffer
+{
+public:
+    VulkanIndexBuffer(void* data, size_t size);
+    ~VulkanIndexBuffer();
+
+    // Bound when draws are recorded into command buffers
+    void Bind() const override {}
+    void Unbind() const override {}
+
+    void SetData(void* buffer, size_t size, uint32_t offset = 0) override;
+
+    size_t GetCount() const override { return (size_t)(m_Size / sizeof(uint32_t)); }
+    size_t GetSize() const override { return m_Size; }
+    // Vulkan handles don't fit a RendererID
+    RendererID GetRendererID() const override { return 0; }
+
+    VkBuffer GetVulkanBuffer() const { return m_Buffer; }
+
+private:
+    VkBuffer m_Buffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+    void* m_MappedData = nullptr;
+    size_t m_Size;
+};
+
+}
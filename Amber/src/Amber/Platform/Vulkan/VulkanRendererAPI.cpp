@@ -0,0 +1,66 @@
+#include "abpch.h"
+#include "VulkanRendererAPI.h"
+
+#include "Amber/Platform/Vulkan/VulkanContext.h"
+
+namespace Amber
+{
+
+static std::string VendorName(uint32_t vendorID)
+{
+    switch (vendorID)
+    {
+        case 0x1002:  return "AMD";
+        case 0x10DE:  return "NVIDIA";
+        case 0x8086:  return "Intel";
+        case 0x13B5:  return "ARM";
+        case 0x5143:  return "Qualcomm";
+        case 0x10005: return "Mesa";
+    }
+
+    std::stringstream ss;
+    ss << "0x" << std::hex << vendorID;
+    return ss.str();
+}
+
+void VulkanRendererAPI::Init()
+{
+    AB_PROFILE_FUNCTION();
+
+    auto& context = VulkanContext::Get();
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(context.GetPhysicalDevice(), &properties);
+
+    auto& caps = RendererAPI::GetCapabilities();
+    caps.Vendor = VendorName(properties.vendorID);
+    caps.Renderer = properties.deviceName;
+    caps.Version = std::to_string(VK_VERSION_MAJOR(properties.apiVersion)) + "." +
+        std::to_string(VK_VERSION_MINOR(properties.apiVersion)) + "." +
+        std::to_string(VK_VERSION_PATCH(properties.apiVersion));
+    caps.MaxColorAttachments = (int)properties.limits.maxColorAttachments;
+    caps.MaxTextureSlots = (int)properties.limits.maxPerStageDescriptorSamplers;
+
+    // Sample counts are a mask of powers of two, the highest bit set is the limit
+    caps.MaxTextureSamples = 1;
+    VkSampleCountFlags sampleCounts = properties.limits.framebufferColorSampleCounts;
+    while (sampleCounts >> 1)
+    {
+        sampleCounts >>= 1;
+        caps.MaxTextureSamples <<= 1;
+    }
+
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(context.GetPhysicalDevice(), nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(context.GetPhysicalDevice(), nullptr, &extensionCount, extensions.data());
+    for (const auto& extension : extensions)
+        caps.Extensions.insert(extension.extensionName);
+}
+
+void VulkanRendererAPI::SetClearColor(const glm::vec4& color)
+{
+    VulkanContext::Get().SetClearColor(color);
+}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Amber/Renderer/RendererAPI.h"
+
+namespace Amber
+{
+
+// State, draws and dispatches need Vulkan pipelines and render passes to be recorded into, so they
+// are no-ops for now. Init reports the device capabilities and the clear color reaches the swapchain.
+class VulkanRendererAPI : public RendererAPI
+{
+public:
+    void Init() override;
+
+    void SetViewport(int x, int y, uint32_t width, uint32_t height) override {}
+
+    void SetClearColor(const glm::vec4& color) override;
+    void Clear() override {}
+
+    void SetLineThickness(float thickness) override {}
+    void SetPointSize(float size) override {}
+    void SetRasterizationMode(RasterizationMode mode) override {}
+    void SetDepthFunction(ComparisonFunc func) override {}
+    void SetStencilFunction(ComparisonFunc func, uint8_t ref, uint8_t mask) override {}
+    void SetStencilMask(uint8_t mask) override {}
+    void SetStencilOperation(StencilOperation stencilFail, StencilOperation depthFail, StencilOperation depthPass) override {}
+
+    void Barrier(uint32_t barriers) override {}
+
+    void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override {}
+    void DispatchIndirect(RendererID argumentBuffer, uint32_t offset) override {}
+
+    void DrawIndexed(uint32_t indexCount, PrimitiveType type = PrimitiveType::Triangles, bool depthTest = true, bool stencilTest = false) override {}
+    void DrawIndexedOffset(uint32_t indexCount, PrimitiveType type = PrimitiveType::Triangles, void* indexBufferPointer = 0, uint32_t offset = 0, bool depthTest = true, bool stencilTest = false) override {}
+};
+
+}
@@ -0,0 +1,55 @@
+#include "abpch.h"
+#include "VulkanVertexBuffer.h"
+
+#include "Amber/Platform/Vulkan/VulkanContext.h"
+
+#include "Amber/Renderer/RenderCommand.h"
+
+namespace Amber
+{
+
+VulkanVertexBuffer::VulkanVertexBuffer(size_t size, VertexBufferUsage usage)
+    : m_Size(size)
+{
+    auto& context = VulkanContext::Get();
+    context.CreateBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_Buffer, m_Memory);
+    VulkanCheckResult(vkMapMemory(context.GetDevice(), m_Memory, 0, size, 0, &m_MappedData));
+}
+
+VulkanVertexBuffer::VulkanVertexBuffer(void* data, size_t size, VertexBufferUsage usage)
+    : VulkanVertexBuffer(size, usage)
+{
+    if (data)
+        memcpy(m_MappedData, data, size);
+}
+
+VulkanVertexBuffer::~VulkanVertexBuffer()
+{
+    VkBuffer buffer = m_Buffer;
+    VkDeviceMemory memory = m_Memory;
+    RenderCommand::Submit([buffer, memory]() {
+        AB_PROFILE_FUNCTION();
+
+        VkDevice device = VulkanContext::Get().GetDevice();
+        vkDestroyBuffer(device, buffer, nullptr);
+        vkFreeMemory(device, memory, nullptr);
+    });
+}
+
+void VulkanVertexBuffer::SetData(void* buffer, size_t size, uint32_t offset)
+{
+    AB_PROFILE_FUNCTION();
+
+    AB_CORE_ASSERT(offset + size <= m_Size, "Vertex buffer write out of range!");
+
+    const void* data = RenderCommand::CopyPayload(buffer, size);
+    Ref<VulkanVertexBuffer> instance = this;
+    RenderCommand::Submit([instance, data, size, offset]() {
+        AB_PROFILE_FUNCTION();
+
+        memcpy((uint8_t*)instance->m_MappedData + offset, data, size);
+    });
+}
+
+}
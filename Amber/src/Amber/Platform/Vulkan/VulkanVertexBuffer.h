@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Amber/Core/Base.h"
+
+#include "Amber/Renderer/VertexBuffer.h"
+
+namespace Amber
+{
+
+// Host visible and persistently mapped, so updates are plain copies. Static buffers move to device
+// local memory once there is a transfer queue to stage them through.
+class VulkanVertexBuffer : public VertexBuffer
+{
+public:
+    VulkanVertexBuffer(size_t size, VertexBufferUsage usage = VertexBufferUsage::Dynamic);
+    VulkanVertexBuffer(void* data, size_t size, VertexBufferUsage usage = VertexBufferUsage::Static);
+    ~VulkanVertexBuffer();
+
+    // Bound when draws are recorded into command buffers
+    void Bind() const override {}
+    void Unbind() const override {}
+
+    void SetData(void* buffer, size_t size, uint32_t offset = 0) override;
+
+    const VertexBufferLayout& GetLayout() const override { return m_Layout; }
+    void SetLayout(const VertexBufferLayout& layout) override { m_Layout = layout; }
+
+    size_t GetSize() const override { return m_Size; }
+    // Vulkan handles don't fit a RendererID
+    RendererID GetRendererID() const override { return 0; }
+
+    VkBuffer GetVulkanBuffer() const { return m_Buffer; }
+
+private:
+    VkBuffer m_Buffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+    void* m_MappedData = nullptr;
+    size_t m_Size;
+    VertexBufferLayout m_Layout;
+};
+
+}
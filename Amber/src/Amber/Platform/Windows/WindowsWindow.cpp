@@ -57,6 +57,9 @@ void WindowsWindow::Init(const WindowProps& props)
         if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
             glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
 #endif
+        // The Vulkan context creates its own surface for the window
+        if (Renderer::GetAPI() == RendererAPI::API::Vulkan)
+            glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 
         m_Window = glfwCreateWindow((int)props.Width, (int)props.Height, m_Data.Title.c_str(), nullptr, nullptr);
         s_GLFWWindowCount++;
@@ -201,10 +204,9 @@ void WindowsWindow::SetVSync(bool enabled)
 {
     AB_PROFILE_FUNCTION();
 
-    if (enabled)
-        glfwSwapInterval(1);
-    else
-        glfwSwapInterval(0);
+    // The Vulkan swapchain always presents in FIFO mode for now
+    if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
+        glfwSwapInterval(enabled ? 1 : 0);
 
     m_Data.VSync = enabled;
 }
@@ -0,0 +1,45 @@
+#include "abpch.h"
+#include "ComputePipeline.h"
+
+#include "Amber/Platform/OpenGL/OpenGLComputePipeline.h"
+
+#include "Amber/Renderer/RenderCommand.h"
+#include "Amber/Renderer/Renderer.h"
+
+namespace Amber
+{
+
+void ComputePipeline::Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+{
+    const auto& spec = GetSpecification();
+    const auto& profiler = Renderer::GetGPUProfiler();
+
+    profiler->BeginScope(spec.DebugName.empty() ? spec.Shader->GetName() : spec.DebugName);
+    RenderCommand::Dispatch(groupsX, groupsY, groupsZ);
+    profiler->EndScope();
+}
+
+void ComputePipeline::DispatchIndirect(const Ref<StorageBuffer>& arguments, uint32_t offset)
+{
+    const auto& spec = GetSpecification();
+    const auto& profiler = Renderer::GetGPUProfiler();
+
+    profiler->BeginScope(spec.DebugName.empty() ? spec.Shader->GetName() : spec.DebugName);
+    RenderCommand::DispatchIndirect(arguments, offset);
+    profiler->EndScope();
+}
+
+Ref<ComputePipeline> ComputePipeline::Create(const ComputePipelineSpecification& spec)
+{
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::OpenGL:  return Ref<OpenGLComputePipeline>::Create(spec);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Compute pipelines are not implemented for Vulkan yet!"); return nullptr;
+        case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
+    }
+
+    AB_CORE_ASSERT(false, "Unknown Renderer API");
+    return nullptr;
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+
+#include "Amber/Renderer/Shader.h"
+#include "Amber/Renderer/StorageBuffer.h"
+#include "Amber/Renderer/Texture.h"
+
+namespace Amber
+{
+
+enum class ImageAccess
+{
+    ReadOnly, WriteOnly, ReadWrite
+};
+
+struct ComputePipelineSpecification
+{
+    Ref<Shader> Shader;
+    // Name of the GPU profiler scope around each dispatch, the shader name when empty
+    std::string DebugName;
+};
+
+// Bindings are recorded into the command queue as they are made, so they apply to every later dispatch
+// until they are replaced. Barriers between dependent dispatches are left to the caller.
+class ComputePipeline : public RefCounted
+{
+public:
+    virtual ~ComputePipeline() = default;
+
+    virtual void Bind() = 0;
+
+    // Binds a whole mip level, every layer of it for cubemaps
+    virtual void BindImage(uint32_t binding, const Ref<Texture>& texture, uint32_t mipLevel = 0, ImageAccess access = ImageAccess::WriteOnly) = 0;
+    virtual void BindTexture(uint32_t slot, const Ref<Texture>& texture) = 0;
+    virtual void BindStorageBuffer(uint32_t binding, const Ref<StorageBuffer>& buffer) = 0;
+
+    // Plain uniforms by explicit location, for small per-dispatch values
+    virtual void SetInt(uint32_t location, int32_t value) = 0;
+    virtual void SetFloat(uint32_t location, float value) = 0;
+
+    void Dispatch(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1);
+    void DispatchIndirect(const Ref<StorageBuffer>& arguments, uint32_t offset = 0);
+
+    virtual ComputePipelineSpecification& GetSpecification() = 0;
+    virtual const ComputePipelineSpecification& GetSpecification() const = 0;
+
+    static uint32_t GetGroupCount(uint32_t size, uint32_t localSize) { return (size + localSize - 1) / localSize; }
+
+    static Ref<ComputePipeline> Create(const ComputePipelineSpecification& spec);
+};
+
+}
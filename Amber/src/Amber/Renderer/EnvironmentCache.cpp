@@ -0,0 +1,341 @@
+#include "abpch.h"
+#include "EnvironmentCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+#include <glad/glad.h>
+
+#include "Amber/Core/Hash.h"
+
+#include "Amber/Renderer/RenderCommand.h"
+
+#include "Amber/Scene/Scene.h"
+
+namespace Amber
+{
+
+static const char* s_CacheDirectory = "assets/cache/environment";
+
+// Bump whenever the filtering shaders change so stale entries are not picked up
+static const uint32_t s_CacheVersion = 1;
+
+static const uint32_t s_BytesPerTexel = 8;  // RGBA16F
+
+namespace DDS
+{
+
+const uint32_t Magic = 0x20534444;  // "DDS "
+const uint32_t FourCCDX10 = 0x30315844;  // "DX10"
+
+const uint32_t FlagCaps = 0x1, FlagHeight = 0x2, FlagWidth = 0x4, FlagPitch = 0x8, FlagPixelFormat = 0x1000, FlagMipMapCount = 0x20000;
+const uint32_t PixelFormatFourCC = 0x4;
+const uint32_t CapsComplex = 0x8, CapsTexture = 0x1000, CapsMipMap = 0x400000;
+const uint32_t Caps2Cubemap = 0x200, Caps2AllFaces = 0xfc00;
+
+const uint32_t FormatR16G16B16A16Float = 10;
+const uint32_t DimensionTexture2D = 3;
+const uint32_t MiscTextureCube = 0x4;
+
+struct PixelFormat
+{
+    uint32_t Size, Flags, FourCC, RGBBitCount, RBitMask, GBitMask, BBitMask, ABitMask;
+};
+
+struct Header
+{
+    uint32_t Size, Flags, Height, Width, PitchOrLinearSize, Depth, MipMapCount;
+    uint32_t Reserved1[11];
+    PixelFormat Format;
+    uint32_t Caps, Caps2, Caps3, Caps4, Reserved2;
+};
+
+struct HeaderDX10
+{
+    uint32_t Format, ResourceDimension, MiscFlag, ArraySize, MiscFlags2;
+};
+
+}
+
+static size_t GetFaceSize(uint32_t size, uint32_t level)
+{
+    size_t levelSize = glm::max(size >> level, 1u);
+    return levelSize * levelSize * s_BytesPerTexel;
+}
+
+static uint64_t HashFile(const std::string& filepath)
+{
+    // Several cache entries share a source, so remember its hash until the file changes
+    struct FileHash
+    {
+        std::filesystem::file_time_type LastWriteTime;
+        uint64_t Hash;
+    };
+    static std::unordered_map<std::string, FileHash> s_FileHashes;
+    static std::mutex s_FileHashesMutex;
+
+    std::error_code error;
+    auto lastWriteTime = std::filesystem::last_write_time(filepath, error);
+    if (error)
+        return 0;
+
+    {
+        // Jobs look up their cache entries on worker threads
+        std::lock_guard<std::mutex> lock(s_FileHashesMutex);
+        auto it = s_FileHashes.find(filepath);
+        if (it != s_FileHashes.end() && it->second.LastWriteTime == lastWriteTime)
+            return it->second.Hash;
+    }
+
+    std::ifstream in(filepath, std::ios::in | std::ios::binary);
+    if (!in)
+        return 0;
+
+    uint64_t hash = Hash::FNV64OffsetBasis;
+    std::vector<byte> chunk(1 << 20);
+    while (in)
+    {
+        in.read((char*)chunk.data(), chunk.size());
+        hash = Hash::FNV64(chunk.data(), (size_t)in.gcount(), hash);
+    }
+
+    std::lock_guard<std::mutex> lock(s_FileHashesMutex);
+    s_FileHashes[filepath] = { lastWriteTime, hash };
+    return hash;
+}
+
+std::string EnvironmentCache::GetCachePath(const std::string& filepath, const EnvironmentSettings& settings)
+{
+    uint64_t hash = HashFile(filepath);
+    if (!hash)
+        return "";
+
+    uint32_t parameters[] = { s_CacheVersion, settings.CubemapSize, settings.SampleCount };
+    hash = Hash::FNV64(parameters, sizeof(parameters), hash);
+
+    std::stringstream ss;
+    ss << s_CacheDirectory << "/" << std::filesystem::path(filepath).stem().string() << "-" << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+Ref<TextureCube> EnvironmentCache::Load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in)
+        return nullptr;
+
+    uint32_t magic = 0;
+    DDS::Header header{};
+    DDS::HeaderDX10 headerDX10{};
+    in.read((char*)&magic, sizeof(magic));
+    in.read((char*)&header, sizeof(header));
+    in.read((char*)&headerDX10, sizeof(headerDX10));
+
+    if (!in || magic != DDS::Magic || header.Format.FourCC != DDS::FourCCDX10 ||
+        headerDX10.Format != DDS::FormatR16G16B16A16Float || !(headerDX10.MiscFlag & DDS::MiscTextureCube) ||
+        header.Width != header.Height || header.MipMapCount != Texture::CalculateMipMapCount(header.Width, header.Height))
+    {
+        AB_CORE_WARN("Ignoring invalid environment cache file '{0}'", path);
+        return nullptr;
+    }
+
+    uint32_t size = header.Width;
+    uint32_t levels = header.MipMapCount;
+
+    std::vector<size_t> levelOffsets(levels);
+    size_t dataSize = 0;
+    for (uint32_t level = 0; level < levels; level++)
+    {
+        levelOffsets[level] = dataSize;
+        dataSize += GetFaceSize(size, level) * 6;
+    }
+
+    // DDS stores each face with its mip chain, the texture wants each mip with its six faces
+    Buffer data;
+    data.Allocate(dataSize);
+    for (uint32_t face = 0; face < 6; face++)
+    {
+        for (uint32_t level = 0; level < levels; level++)
+        {
+            size_t faceSize = GetFaceSize(size, level);
+            in.read((char*)data.Data + levelOffsets[level] + face * faceSize, faceSize);
+        }
+    }
+
+    if (!in)
+    {
+        AB_CORE_WARN("Environment cache file '{0}' is truncated", path);
+        return nullptr;
+    }
+
+    return TextureCube::Create(TextureFormat::Float16, size, size, std::move(data));
+}
+
+// Same layout as Load reads, the data holds each mip with its six faces
+static void WriteCubemap(const std::string& path, uint32_t size, uint32_t levels, const byte* data)
+{
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    if (!out)
+    {
+        AB_CORE_WARN("Could not write environment cache file '{0}'", path);
+        return;
+    }
+
+    DDS::Header header{};
+    header.Size = sizeof(DDS::Header);
+    header.Flags = DDS::FlagCaps | DDS::FlagHeight | DDS::FlagWidth | DDS::FlagPitch | DDS::FlagPixelFormat | DDS::FlagMipMapCount;
+    header.Height = size;
+    header.Width = size;
+    header.PitchOrLinearSize = size * s_BytesPerTexel;
+    header.MipMapCount = levels;
+    header.Format.Size = sizeof(DDS::PixelFormat);
+    header.Format.Flags = DDS::PixelFormatFourCC;
+    header.Format.FourCC = DDS::FourCCDX10;
+    header.Caps = DDS::CapsComplex | DDS::CapsTexture | DDS::CapsMipMap;
+    header.Caps2 = DDS::Caps2Cubemap | DDS::Caps2AllFaces;
+
+    DDS::HeaderDX10 headerDX10{};
+    headerDX10.Format = DDS::FormatR16G16B16A16Float;
+    headerDX10.ResourceDimension = DDS::DimensionTexture2D;
+    headerDX10.MiscFlag = DDS::MiscTextureCube;
+    headerDX10.ArraySize = 1;
+
+    out.write((const char*)&DDS::Magic, sizeof(DDS::Magic));
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)&headerDX10, sizeof(headerDX10));
+
+    std::vector<size_t> levelOffsets(levels);
+    size_t offset = 0;
+    for (uint32_t level = 0; level < levels; level++)
+    {
+        levelOffsets[level] = offset;
+        offset += GetFaceSize(size, level) * 6;
+    }
+
+    for (uint32_t face = 0; face < 6; face++)
+    {
+        for (uint32_t level = 0; level < levels; level++)
+        {
+            size_t faceSize = GetFaceSize(size, level);
+            out.write((const char*)data + levelOffsets[level] + face * faceSize, faceSize);
+        }
+    }
+}
+
+bool EnvironmentCache::Load(const std::string& path, std::array<glm::vec3, 9>& coefficients)
+{
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in)
+        return false;
+
+    in.read((char*)coefficients.data(), sizeof(coefficients));
+    return (size_t)in.gcount() == sizeof(coefficients);
+}
+
+void EnvironmentCache::Store(const std::string& path, const std::array<glm::vec3, 9>& coefficients)
+{
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    if (!out)
+    {
+        AB_CORE_WARN("Could not write environment cache file '{0}'", path);
+        return;
+    }
+
+    out.write((const char*)coefficients.data(), sizeof(coefficients));
+}
+
+EnvironmentCacheWrite::EnvironmentCacheWrite(const std::string& path, const Ref<TextureCube>& texture)
+    : m_Path(path), m_Texture(texture)
+{
+    AB_CORE_ASSERT(texture->GetFormat() == TextureFormat::Float16, "Only HDR environment maps can be cached!");
+
+    Ref<EnvironmentCacheWrite> instance = this;
+    RenderCommand::Submit([instance]() mutable {
+        uint32_t size = instance->m_Texture->GetWidth();
+        uint32_t levels = instance->m_Texture->GetMipLevelCount();
+
+        size_t dataSize = 0;
+        for (uint32_t level = 0; level < levels; level++)
+            dataSize += GetFaceSize(size, level) * 6;
+
+        // Persistently mapped so the worker can read the copy without another trip through the render thread
+        const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCreateBuffers(1, &instance->m_Buffer);
+        glNamedBufferStorage(instance->m_Buffer, dataSize, nullptr, flags);
+        instance->m_MappedData = glMapNamedBufferRange(instance->m_Buffer, 0, dataSize, flags);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, instance->m_Buffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+        size_t offset = 0;
+        for (uint32_t level = 0; level < levels; level++)
+        {
+            size_t levelSize = GetFaceSize(size, level) * 6;
+            glGetTextureImage(instance->m_Texture->GetRendererID(), level, GL_RGBA, GL_HALF_FLOAT, (GLsizei)levelSize, (void*)offset);
+            offset += levelSize;
+        }
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        instance->m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    });
+}
+
+bool EnvironmentCacheWrite::Poll()
+{
+    switch (m_Stage.load())
+    {
+        case Stage::Copying:
+        {
+            // The fence is only checked on the render thread, so a signal is seen on a later poll
+            Ref<EnvironmentCacheWrite> instance = this;
+            RenderCommand::Submit([instance]() mutable {
+                if (instance->m_Stage != Stage::Copying)
+                    return;
+
+                GLenum status = glClientWaitSync((GLsync)instance->m_Fence, 0, 0);
+                if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+                {
+                    glDeleteSync((GLsync)instance->m_Fence);
+                    instance->m_Fence = nullptr;
+                    instance->m_Stage = Stage::Copied;
+                }
+            });
+            return false;
+        }
+        case Stage::Copied:
+        {
+            Ref<EnvironmentCacheWrite> instance = this;
+            m_Write = std::async(std::launch::async, [instance]() {
+                WriteCubemap(instance->m_Path, instance->m_Texture->GetWidth(), instance->m_Texture->GetMipLevelCount(), (const byte*)instance->m_MappedData);
+            });
+            m_Stage = Stage::Writing;
+            return false;
+        }
+        case Stage::Writing:
+        {
+            if (m_Write.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+
+            m_Write.get();
+
+            Ref<EnvironmentCacheWrite> instance = this;
+            RenderCommand::Submit([instance]() {
+                glUnmapNamedBuffer(instance->m_Buffer);
+                glDeleteBuffers(1, &instance->m_Buffer);
+            });
+            m_Stage = Stage::Done;
+            return true;
+        }
+    }
+
+    return true;
+}
+
+}
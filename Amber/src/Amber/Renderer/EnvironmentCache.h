@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+
+#include "Amber/Core/Base.h"
+
+#include "Amber/Renderer/Texture.h"
+
+namespace Amber
+{
+
+struct EnvironmentSettings;
+
+// Prefiltered environment cubemaps stored as RGBA16F DDS files with their full mip chain
+class EnvironmentCache
+{
+public:
+    // Keyed by the contents of the source image and the filter settings
+    static std::string GetCachePath(const std::string& filepath, const EnvironmentSettings& settings);
+
+    // Records the upload of a cached map, safe to call from a worker thread that is recording a queue
+    static Ref<TextureCube> Load(const std::string& path);
+
+    static bool Load(const std::string& path, std::array<glm::vec3, 9>& coefficients);
+    static void Store(const std::string& path, const std::array<glm::vec3, 9>& coefficients);
+};
+
+// Stores a cubemap in the cache without waiting on the GPU or the disk. The mip chain is copied into a mapped
+// buffer behind a fence, the file is written on a worker thread once the fence has signaled.
+class EnvironmentCacheWrite : public RefCounted
+{
+public:
+    EnvironmentCacheWrite(const std::string& path, const Ref<TextureCube>& texture);
+
+    // Call once a frame, returns true once the file has been written and the buffer released
+    bool Poll();
+
+private:
+    enum class Stage
+    {
+        Copying = 0, Copied, Writing, Done
+    };
+
+    std::string m_Path;
+    Ref<TextureCube> m_Texture;
+
+    RendererID m_Buffer = 0;
+    void* m_MappedData = nullptr;
+    void* m_Fence = nullptr;
+
+    std::atomic<Stage> m_Stage = Stage::Copying;
+    std::future<void> m_Write;
+};
+
+}
@@ -13,6 +13,7 @@ Ref<Framebuffer> Framebuffer::Create(const FramebufferSpecification& spec)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLFramebuffer>::Create(spec);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Framebuffers are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -20,16 +21,105 @@ Ref<Framebuffer> Framebuffer::Create(const FramebufferSpecification& spec)
     return nullptr;
 }
 
+uint64_t Framebuffer::GetMemorySize(const FramebufferSpecification& spec)
+{
+    uint64_t pixels = (uint64_t)spec.Width * spec.Height * spec.Samples;
+
+    uint64_t colorSize = 0;
+    switch (spec.Format)
+    {
+        case FramebufferFormat::RGBA8:      colorSize = 4; break;
+        case FramebufferFormat::RGBA8_SRGB: colorSize = 4; break;
+        case FramebufferFormat::RGBA16F:    colorSize = 8; break;
+        case FramebufferFormat::R11G11B10F: colorSize = 4; break;
+    }
+
+    uint64_t depthSize = spec.DepthAttachmentType == DepthBufferType::None ? 0 : 4;
+
+    return pixels * (colorSize * spec.ColorAttachmentCount + depthSize);
+}
+
 FramebufferPool* FramebufferPool::s_Instance = new FramebufferPool();
 
-WeakRef<Framebuffer> FramebufferPool::AllocateBuffer()
+static DepthBufferType GetEffectiveDepthType(const FramebufferSpecification& spec)
 {
-    return WeakRef<Framebuffer>();
+    // Multisampled framebuffers always use depth textures
+    if (spec.Samples > 1 && spec.DepthAttachmentType == DepthBufferType::Renderbuffer)
+        return DepthBufferType::Texture;
+
+    return spec.DepthAttachmentType;
 }
 
-void FramebufferPool::Add(WeakRef<Framebuffer> frameBuffer)
+static bool IsCompatible(const FramebufferSpecification& a, const FramebufferSpecification& b)
 {
-    m_Pool.push_back(frameBuffer);
+    return a.Width == b.Width && a.Height == b.Height &&
+        a.Format == b.Format &&
+        a.ColorAttachmentCount == b.ColorAttachmentCount &&
+        a.Samples == b.Samples &&
+        GetEffectiveDepthType(a) == GetEffectiveDepthType(b) &&
+        (GetEffectiveDepthType(a) == DepthBufferType::None || a.StencilBuffer == b.StencilBuffer) &&
+        a.SwapChainTarget == b.SwapChainTarget;
+}
+
+Ref<Framebuffer> FramebufferPool::AllocateBuffer(const FramebufferSpecification& spec)
+{
+    for (auto& pooled : m_Pool)
+    {
+        if (!pooled.InUse && IsCompatible(pooled.Framebuffer->GetSpecification(), spec))
+        {
+            pooled.InUse = true;
+            pooled.LastUsedFrame = m_FrameIndex;
+            pooled.Framebuffer->GetSpecification().ClearColor = spec.ClearColor;
+            return pooled.Framebuffer;
+        }
+    }
+
+    PooledFramebuffer& pooled = m_Pool.emplace_back();
+    pooled.Framebuffer = Framebuffer::Create(spec);
+    pooled.InUse = true;
+    pooled.LastUsedFrame = m_FrameIndex;
+
+    return pooled.Framebuffer;
+}
+
+void FramebufferPool::ReleaseBuffer(const Ref<Framebuffer>& framebuffer)
+{
+    for (auto& pooled : m_Pool)
+    {
+        if (pooled.Framebuffer == framebuffer)
+        {
+            AB_CORE_ASSERT(pooled.InUse, "Framebuffer released twice!");
+            pooled.InUse = false;
+            return;
+        }
+    }
+
+    AB_CORE_ASSERT(false, "Framebuffer does not belong to the pool!");
+}
+
+void FramebufferPool::EndFrame()
+{
+    for (auto it = m_Pool.begin(); it != m_Pool.end();)
+    {
+        if (it->InUse)
+            AB_CORE_WARN("Transient framebuffer was not released this frame!");
+
+        if (!it->InUse && m_FrameIndex - it->LastUsedFrame > s_MaxUnusedFrames)
+            it = m_Pool.erase(it);
+        else
+            it++;
+    }
+
+    m_FrameIndex++;
+}
+
+uint64_t FramebufferPool::GetMemoryUsage() const
+{
+    uint64_t size = 0;
+    for (auto& pooled : m_Pool)
+        size += Framebuffer::GetMemorySize(pooled.Framebuffer->GetSpecification());
+
+    return size;
 }
 
 }
\ No newline at end of file
@@ -13,7 +13,11 @@ enum class FramebufferFormat
 {
     None = 0,
     RGBA8,
-    RGBA16F
+    // Holds already gamma-encoded output, sampling returns the stored values
+    RGBA8_SRGB,
+    RGBA16F,
+    // HDR color at half the size of RGBA16F, without alpha
+    R11G11B10F
 };
 
 enum class DepthBufferType
@@ -29,6 +33,7 @@ struct FramebufferSpecification
     uint32_t Height = 720;
     FramebufferFormat Format;
 
+    // Zero makes a depth-only framebuffer
     uint32_t ColorAttachmentCount = 1;
     DepthBufferType DepthAttachmentType = DepthBufferType::Renderbuffer;
     uint32_t Samples = 1;
@@ -50,30 +55,51 @@ public:
     virtual void Bind() const = 0;
     virtual void Unbind() const = 0;
 
+    // Copies the first color attachment, resolving samples if needed
+    virtual void BlitTo(const Ref<Framebuffer>& target, uint32_t width, uint32_t height) const = 0;
+
     virtual RendererID GetRendererID() const = 0;
     virtual const std::vector<Ref<Texture2D>>& GetColorAttachments() const = 0;
     virtual RendererID GetDepthAttachment() const = 0;
+    virtual const Ref<Texture2D>& GetDepthTexture() const = 0;
 
     virtual FramebufferSpecification& GetSpecification() = 0;
     virtual const FramebufferSpecification& GetSpecification() const = 0;
 
     static Ref<Framebuffer> Create(const FramebufferSpecification& spec);
+    static uint64_t GetMemorySize(const FramebufferSpecification& spec);
 };
 
+// Transient render targets. Buffers released by one pass are handed to the next pass
+// that asks for the same description, so non-overlapping lifetimes share memory.
 class FramebufferPool final
 {
 public:
-    WeakRef<Framebuffer> AllocateBuffer();
-    void Add(WeakRef<Framebuffer> frameBuffer);
+    struct PooledFramebuffer
+    {
+        Ref<Framebuffer> Framebuffer;
+        bool InUse = false;
+        uint64_t LastUsedFrame = 0;
+    };
+
+    Ref<Framebuffer> AllocateBuffer(const FramebufferSpecification& spec);
+    void ReleaseBuffer(const Ref<Framebuffer>& framebuffer);
+
+    // Frees buffers that have not been requested for a few frames
+    void EndFrame();
+
+    uint64_t GetMemoryUsage() const;
 
-    std::vector<WeakRef<Framebuffer>>& GetAll() { return m_Pool; }
-    const std::vector<WeakRef<Framebuffer>>& GetAll() const { return m_Pool; }
+    std::vector<PooledFramebuffer>& GetAll() { return m_Pool; }
+    const std::vector<PooledFramebuffer>& GetAll() const { return m_Pool; }
 
     static FramebufferPool* GetGlobal() { return s_Instance; }
 
 private:
-    std::vector<WeakRef<Framebuffer>> m_Pool;
+    std::vector<PooledFramebuffer> m_Pool;
+    uint64_t m_FrameIndex = 0;
 
+    static const uint64_t s_MaxUnusedFrames = 4;
     static FramebufferPool* s_Instance;
 };
 
@@ -0,0 +1,35 @@
+#include "abpch.h"
+#include "GPUProfiler.h"
+
+#include "Amber/Platform/OpenGL/OpenGLGPUProfiler.h"
+
+#include "Amber/Renderer/Renderer.h"
+
+namespace Amber
+{
+
+Ref<GPUProfiler> GPUProfiler::Create()
+{
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::OpenGL:  return Ref<OpenGLGPUProfiler>::Create();
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "GPU profiling is not implemented for Vulkan yet!"); return nullptr;
+        case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
+    }
+
+    AB_CORE_ASSERT(false, "Unknown Renderer API");
+    return nullptr;
+}
+
+float GPUProfiler::GetMilliseconds(const std::string& name) const
+{
+    for (auto& result : GetResults())
+    {
+        if (result.Name == name)
+            return result.Milliseconds;
+    }
+
+    return 0.0f;
+}
+
+}
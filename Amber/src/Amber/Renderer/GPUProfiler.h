@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Amber/Core/Base.h"
+
+namespace Amber
+{
+
+// Named GPU timestamp scopes, recorded on the render thread and read back a frame later without stalling
+class GPUProfiler : public RefCounted
+{
+public:
+    struct Result
+    {
+        std::string Name;
+        uint32_t Depth = 0;
+        uint32_t Count = 0;
+        float Milliseconds = 0.0f;
+    };
+
+    virtual ~GPUProfiler() = default;
+
+    virtual void BeginScope(const std::string& name) = 0;
+    virtual void EndScope() = 0;
+
+    // Swaps query buffers and reads back the other frame's scopes if they have finished
+    virtual void EndFrame() = 0;
+
+    // Scopes with the same name are summed, in the order they were first opened
+    virtual const std::vector<Result>& GetResults() const = 0;
+    // Summed time of the scopes with this name, 0 if none were recorded
+    float GetMilliseconds(const std::string& name) const;
+
+    static Ref<GPUProfiler> Create();
+};
+
+}
@@ -0,0 +1,137 @@
+#include "abpch.h"
+#include "GPUScene.h"
+
+namespace Amber
+{
+
+GPUScene::GPUScene(uint32_t capacity)
+    : m_Capacity(glm::max(capacity, 1u))
+{
+}
+
+void GPUScene::SetObject(uint32_t id, const glm::mat4& transform, const Math::AABB& boundingBox)
+{
+    uint32_t slot;
+    auto it = m_Slots.find(id);
+    if (it != m_Slots.end())
+    {
+        slot = it->second;
+    }
+    else
+    {
+        if (!m_FreeSlots.empty())
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            slot = (uint32_t)m_Objects.size();
+            m_Objects.emplace_back();
+            m_Dirty.push_back(false);
+        }
+        m_Slots[id] = slot;
+    }
+
+    // World bounds from the transformed center and the absolute basis applied to the extents
+    glm::vec3 center = transform * glm::vec4((boundingBox.Min + boundingBox.Max) * 0.5f, 1.0f);
+    glm::vec3 extents = (boundingBox.Max - boundingBox.Min) * 0.5f;
+    glm::mat3 basis(transform);
+    for (uint32_t i = 0; i < 3; i++)
+        basis[i] = glm::abs(basis[i]);
+    extents = basis * extents;
+
+    auto& object = m_Objects[slot];
+    object.Transform = transform;
+    object.NormalTransform = glm::mat4(glm::transpose(glm::inverse(glm::mat3(transform))));
+    object.BoundsMin = glm::vec4(center - extents, 1.0f);
+    object.BoundsMax = glm::vec4(center + extents, 1.0f);
+
+    if (!m_Dirty[slot])
+    {
+        m_Dirty[slot] = true;
+        m_DirtySlots.push_back(slot);
+    }
+}
+
+void GPUScene::RemoveObject(uint32_t id)
+{
+    auto it = m_Slots.find(id);
+    if (it == m_Slots.end())
+        return;
+
+    // Nothing indexes a free slot, so its stale contents never need uploading
+    m_FreeSlots.push_back(it->second);
+    m_Slots.erase(it);
+}
+
+int32_t GPUScene::GetSlot(uint32_t id) const
+{
+    auto it = m_Slots.find(id);
+    return it != m_Slots.end() ? (int32_t)it->second : -1;
+}
+
+void GPUScene::Upload()
+{
+    m_UploadedObjects = 0;
+    m_UploadRanges = 0;
+
+    if (m_Objects.size() > m_Capacity)
+    {
+        while (m_Capacity < m_Objects.size())
+            m_Capacity *= 2;
+        m_Reallocate = true;
+    }
+
+    if (m_Reallocate)
+    {
+        m_Buffer = StorageBuffer::Create(sizeof(Object) * m_Capacity);
+        if (!m_Objects.empty())
+        {
+            m_Buffer->SetData(m_Objects.data(), sizeof(Object) * m_Objects.size());
+            m_UploadedObjects = (uint32_t)m_Objects.size();
+            m_UploadRanges = 1;
+        }
+
+        for (uint32_t slot : m_DirtySlots)
+            m_Dirty[slot] = false;
+        m_DirtySlots.clear();
+        m_Reallocate = false;
+        return;
+    }
+
+    if (m_DirtySlots.empty())
+        return;
+
+    std::sort(m_DirtySlots.begin(), m_DirtySlots.end());
+
+    uint32_t first = m_DirtySlots[0], last = first;
+    for (size_t i = 1; i <= m_DirtySlots.size(); i++)
+    {
+        if (i < m_DirtySlots.size() && m_DirtySlots[i] == last + 1)
+        {
+            last = m_DirtySlots[i];
+            continue;
+        }
+
+        uint32_t count = last - first + 1;
+        m_Buffer->SetData(&m_Objects[first], sizeof(Object) * count, sizeof(Object) * first);
+        m_UploadedObjects += count;
+        m_UploadRanges++;
+
+        if (i < m_DirtySlots.size())
+            first = last = m_DirtySlots[i];
+    }
+
+    for (uint32_t slot : m_DirtySlots)
+        m_Dirty[slot] = false;
+    m_DirtySlots.clear();
+}
+
+void GPUScene::Bind() const
+{
+    if (m_Buffer)
+        m_Buffer->Bind(Binding);
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Amber/Math/AABB.h"
+
+#include "Amber/Renderer/StorageBuffer.h"
+
+namespace Amber
+{
+
+// Per-object transforms and world bounds kept resident in a storage buffer. An object keeps its
+// slot for as long as it exists and only the slots written since the last upload are sent.
+class GPUScene : public RefCounted
+{
+public:
+    static constexpr uint32_t Binding = 0;
+
+    // Matches SceneObject in the standard shaders, std430
+    struct Object
+    {
+        glm::mat4 Transform;
+        glm::mat4 NormalTransform;
+        glm::vec4 BoundsMin;
+        glm::vec4 BoundsMax;
+    };
+
+    GPUScene(uint32_t capacity = 256);
+
+    void SetObject(uint32_t id, const glm::mat4& transform, const Math::AABB& boundingBox);
+    void RemoveObject(uint32_t id);
+
+    // -1 when the object is not in the scene
+    int32_t GetSlot(uint32_t id) const;
+    const Object& GetObject(uint32_t slot) const { return m_Objects[slot]; }
+
+    // Coalesces the dirty slots into contiguous ranges, one write per range
+    void Upload();
+    void Bind() const;
+
+    uint32_t GetObjectCount() const { return (uint32_t)m_Slots.size(); }
+    uint32_t GetUploadedObjectCount() const { return m_UploadedObjects; }
+    uint32_t GetUploadRangeCount() const { return m_UploadRanges; }
+
+private:
+    std::vector<Object> m_Objects;
+    std::unordered_map<uint32_t, uint32_t> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+
+    std::vector<uint32_t> m_DirtySlots;
+    std::vector<bool> m_Dirty;
+
+    Ref<StorageBuffer> m_Buffer;
+    uint32_t m_Capacity;
+    bool m_Reallocate = true;
+
+    uint32_t m_UploadedObjects = 0;
+    uint32_t m_UploadRanges = 0;
+};
+
+}
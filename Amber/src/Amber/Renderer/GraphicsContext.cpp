@@ -4,6 +4,7 @@
 #include "Amber/Renderer/Renderer.h"
 
 #include "Amber/Platform/OpenGL/OpenGLContext.h"
+#include "Amber/Platform/Vulkan/VulkanContext.h"
 
 namespace Amber
 {
@@ -13,6 +14,7 @@ Scope<GraphicsContext> GraphicsContext::Create(void* window)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return CreateScope<OpenGLContext>(static_cast<GLFWwindow*>(window));
+        case RendererAPI::API::Vulkan:  return CreateScope<VulkanContext>(static_cast<GLFWwindow*>(window));
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
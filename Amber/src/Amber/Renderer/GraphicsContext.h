@@ -8,6 +8,8 @@ namespace Amber
 class GraphicsContext
 {
 public:
+    virtual ~GraphicsContext() = default;
+
     virtual void Init() = 0;
     virtual void SwapBuffers() = 0;
 
@@ -2,6 +2,7 @@
 #include "IndexBuffer.h"
 
 #include "Amber/Platform/OpenGL/OpenGLIndexBuffer.h"
+#include "Amber/Platform/Vulkan/VulkanIndexBuffer.h"
 
 #include "Amber/Renderer/Renderer.h"
 
@@ -13,6 +14,7 @@ Ref<IndexBuffer> IndexBuffer::Create(void* data, size_t size)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLIndexBuffer>::Create(data, size);
+        case RendererAPI::API::Vulkan:  return Ref<VulkanIndexBuffer>::Create(data, size);
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -4,6 +4,110 @@
 namespace Amber
 {
 
+void MaterialUniformBlock::Allocate(uint32_t size)
+{
+    m_Data.Allocate(size);
+    m_Data.ZeroInitialize();
+    m_UniformBuffer = UniformBuffer::Create(size);
+    MarkDirty(0, size);
+}
+
+void MaterialUniformBlock::Clear()
+{
+    m_Data.Clear();
+    m_UniformBuffer = nullptr;
+    m_DirtyBegin = m_DirtyEnd = 0;
+}
+
+bool MaterialUniformBlock::Write(const ShaderUniform* uniform, const void* value)
+{
+    const auto& spans = uniform->GetSpans();
+    const auto& last = spans.back();
+    uint32_t offset = uniform->GetOffset();
+    AB_CORE_ASSERT(offset + last.BlockOffset + last.Size <= m_Data.Size, "Buffer overflow!");
+
+    // Values set every frame are usually unchanged, those don't need an upload
+    bool changed = false;
+    for (const auto& span : spans)
+    {
+        byte* dest = m_Data.Data + offset + span.BlockOffset;
+        const byte* src = (const byte*)value + span.SourceOffset;
+        if (memcmp(dest, src, span.Size) != 0)
+        {
+            memcpy(dest, src, span.Size);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        MarkDirty(offset, last.BlockOffset + last.Size);
+
+    return changed;
+}
+
+void MaterialUniformBlock::Read(const ShaderUniform* uniform, void* value) const
+{
+    const auto& spans = uniform->GetSpans();
+    const auto& last = spans.back();
+    uint32_t offset = uniform->GetOffset();
+    AB_CORE_ASSERT(offset + last.BlockOffset + last.Size <= m_Data.Size, "Buffer overflow!");
+
+    for (const auto& span : spans)
+        memcpy((byte*)value + span.SourceOffset, m_Data.Data + offset + span.BlockOffset, span.Size);
+}
+
+void MaterialUniformBlock::CopyUniform(const ShaderUniform* uniform, const MaterialUniformBlock& source)
+{
+    const auto& last = uniform->GetSpans().back();
+    uint32_t offset = uniform->GetOffset();
+    uint32_t size = last.BlockOffset + last.Size;
+    AB_CORE_ASSERT(offset + size <= m_Data.Size && offset + size <= source.m_Data.Size, "Buffer overflow!");
+
+    if (memcmp(m_Data.Data + offset, source.m_Data.Data + offset, size) == 0)
+        return;
+
+    memcpy(m_Data.Data + offset, source.m_Data.Data + offset, size);
+    MarkDirty(offset, size);
+}
+
+void MaterialUniformBlock::CopyFrom(const MaterialUniformBlock& source)
+{
+    AB_CORE_ASSERT(m_Data.Size == source.m_Data.Size, "Material blocks differ in size!");
+
+    memcpy(m_Data.Data, source.m_Data.Data, m_Data.Size);
+    MarkDirty(0, (uint32_t)m_Data.Size);
+}
+
+void MaterialUniformBlock::Bind(uint32_t binding)
+{
+    if (m_DirtyEnd > m_DirtyBegin)
+    {
+        m_UniformBuffer->SetData(m_Data.Data + m_DirtyBegin, m_DirtyEnd - m_DirtyBegin, m_DirtyBegin);
+        m_DirtyBegin = m_DirtyEnd = 0;
+    }
+
+    m_UniformBuffer->Bind(binding);
+}
+
+void MaterialUniformBlock::MarkDirty(uint32_t offset, uint32_t size)
+{
+    if (m_DirtyEnd == m_DirtyBegin)
+    {
+        m_DirtyBegin = offset;
+        m_DirtyEnd = offset + size;
+        return;
+    }
+
+    if (offset < m_DirtyBegin)
+        m_DirtyBegin = offset;
+    if (offset + size > m_DirtyEnd)
+        m_DirtyEnd = offset + size;
+}
+
+/////////////////////////////////////////////////////////////////////
+////////     MATERIAL     ///////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+
 Material::Material(const Ref<Shader>& shader)
     : m_Shader(shader)
 {
@@ -20,14 +124,13 @@ Material::~Material()
 
 void Material::Bind()
 {
-    m_Shader->Bind();
+    GetVariant(m_TextureKeywords)->Bind();
 
-    // Pixel shader has to be set first for uniforms that appear in both shaders
-    if (m_PSUniformStorageBuffer)
-        m_Shader->SetPSMaterialUniformBuffer(m_PSUniformStorageBuffer);
+    if (m_VSUniforms)
+        m_VSUniforms.Bind(m_Shader->GetVSMaterialUniformBuffer().GetRegister());
 
-    if (m_VSUniformStorageBuffer)
-        m_Shader->SetVSMaterialUniformBuffer(m_VSUniformStorageBuffer);
+    if (m_PSUniforms)
+        m_PSUniforms.Bind(m_Shader->GetPSMaterialUniformBuffer().GetRegister());
 
     BindTextures();
 }
@@ -37,35 +140,42 @@ void Material::Reset(Ref<Shader> shader)
     if (shader)
         m_Shader = shader;
 
-    m_VSUniformStorageBuffer.Clear();
-    m_PSUniformStorageBuffer.Clear();
+    m_VSUniforms.Clear();
+    m_PSUniforms.Clear();
     AllocateStorage();
     for (auto instance : m_MaterialInstances)
     {
         instance->m_Material = this;
-        instance->m_VSUniformStorageBuffer.Clear();
-        instance->m_PSUniformStorageBuffer.Clear();
+        instance->m_VSUniforms.Clear();
+        instance->m_PSUniforms.Clear();
         instance->AllocateStorage();
         instance->m_Textures.clear();
+        instance->m_TextureKeywords = 0;
+        instance->m_DisabledKeywords = 0;
     }
     m_Textures.clear();
+    m_TextureKeywords = 0;
 }
 
 void Material::AllocateStorage()
 {
+    uint32_t uniformCount = 0;
+
     if (m_Shader->HasVSMaterialUniformBuffer())
     {
-        const auto& vsBuffer = m_Shader->GetVSMaterialUniformBuffer();
-        m_VSUniformStorageBuffer.Allocate(vsBuffer.GetSize());
-        m_VSUniformStorageBuffer.ZeroInitialize();
+        m_VSUniforms.Allocate(m_Shader->GetVSMaterialUniformBuffer().GetSize());
+        uniformCount += (uint32_t)m_Shader->GetVSMaterialUniformBuffer().GetUniforms().size();
     }
 
     if (m_Shader->HasPSMaterialUniformBuffer())
     {
-        const auto& psBuffer = m_Shader->GetPSMaterialUniformBuffer();
-        m_PSUniformStorageBuffer.Allocate(psBuffer.GetSize());
-        m_PSUniformStorageBuffer.ZeroInitialize();
+        m_PSUniforms.Allocate(m_Shader->GetPSMaterialUniformBuffer().GetSize());
+        uniformCount += (uint32_t)m_Shader->GetPSMaterialUniformBuffer().GetUniforms().size();
     }
+
+    // Instances keep their overrides in a 64-bit mask
+    AB_CORE_ASSERT(uniformCount <= 64, "Materials support at most 64 uniforms!");
+    m_UniformVersions.assign(uniformCount, 0);
 }
 
 void Material::BindTextures() const
@@ -78,65 +188,44 @@ void Material::BindTextures() const
     }
 }
 
-ShaderUniform* Material::FindUniform(const std::string& name) const
+// Texture keywords only add features on top of the keywords the material's shader was created with
+Ref<Shader> Material::GetVariant(uint32_t keywords) const
 {
-    if (m_VSUniformStorageBuffer)
-    {
-        const auto& uniforms = m_Shader->GetVSMaterialUniformBuffer().GetUniforms();
-        for (auto uniform : uniforms)
-        {
-            if (uniform->GetName() == name)
-                return uniform;
-        }
-    }
-
-    if (m_PSUniformStorageBuffer)
-    {
-        const auto& uniforms = m_Shader->GetPSMaterialUniformBuffer().GetUniforms();
-        for (auto uniform : uniforms)
-        {
-            if (uniform->GetName() == name)
-                return uniform;
-        }
-    }
-
-    return nullptr;
+    return keywords ? m_Shader->GetVariant(m_Shader->GetKeywords() | keywords) : m_Shader;
 }
 
-ShaderResource* Material::FindResource(const std::string& name) const
+ShaderUniform* Material::FindUniform(MaterialProperty property) const
 {
-    auto& resources = m_Shader->GetResources();
-    for (auto resource : resources)
-    {
-        if (resource->GetName() == name)
-            return resource;
-    }
+    return m_Shader->FindUniform(property.NameHash);
+}
 
-    return nullptr;
+ShaderResource* Material::FindResource(MaterialProperty property) const
+{
+    return m_Shader->FindResource(property.NameHash);
 }
 
-Buffer& Material::GetUniformBufferTarget(ShaderUniform* uniform)
+MaterialUniformBlock& Material::GetUniformBlockTarget(ShaderUniform* uniform)
 {
     switch (uniform->GetDomain())
     {
-        case ShaderDomain::Vertex:  return m_VSUniformStorageBuffer;
-        case ShaderDomain::Pixel:   return m_PSUniformStorageBuffer;
+        case ShaderDomain::Vertex:  return m_VSUniforms;
+        case ShaderDomain::Pixel:   return m_PSUniforms;
     }
 
     AB_CORE_ASSERT(false, "Invalid shader domain! Material does not support this shader type.");
-    return m_VSUniformStorageBuffer;
+    return m_VSUniforms;
 }
 
-const Buffer& Material::GetUniformBufferTarget(ShaderUniform* uniform) const
+const MaterialUniformBlock& Material::GetUniformBlockTarget(ShaderUniform* uniform) const
 {
     switch (uniform->GetDomain())
     {
-        case ShaderDomain::Vertex:  return m_VSUniformStorageBuffer;
-        case ShaderDomain::Pixel:   return m_PSUniformStorageBuffer;
+        case ShaderDomain::Vertex:  return m_VSUniforms;
+        case ShaderDomain::Pixel:   return m_PSUniforms;
     }
 
     AB_CORE_ASSERT(false, "Invalid shader domain! Material does not support this shader type.");
-    return m_VSUniformStorageBuffer;
+    return m_VSUniforms;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -157,13 +246,16 @@ MaterialInstance::~MaterialInstance()
 
 void MaterialInstance::Bind()
 {
-    m_Material->GetShader()->Bind();
+    SyncWithMaterial();
+
+    auto shader = m_Material->GetShader();
+    m_Material->GetVariant(GetEnabledKeywords())->Bind();
 
-    if (m_PSUniformStorageBuffer)
-        m_Material->GetShader()->SetPSMaterialUniformBuffer(m_PSUniformStorageBuffer);
+    if (m_VSUniforms)
+        m_VSUniforms.Bind(shader->GetVSMaterialUniformBuffer().GetRegister());
 
-    if (m_VSUniformStorageBuffer)
-        m_Material->GetShader()->SetVSMaterialUniformBuffer(m_VSUniformStorageBuffer);
+    if (m_PSUniforms)
+        m_PSUniforms.Bind(shader->GetPSMaterialUniformBuffer().GetRegister());
 
     m_Material->BindTextures();
     BindTextures();
@@ -173,17 +265,29 @@ void MaterialInstance::AllocateStorage()
 {
     if (m_Material->GetShader()->HasVSMaterialUniformBuffer())
     {
-        const auto& vsBuffer = m_Material->GetShader()->GetVSMaterialUniformBuffer();
-        m_VSUniformStorageBuffer.Allocate(vsBuffer.GetSize());
-        m_VSUniformStorageBuffer.Write(m_Material->GetVSUniformStorageBuffer().Data, vsBuffer.GetSize());
+        m_VSUniforms.Allocate(m_Material->GetShader()->GetVSMaterialUniformBuffer().GetSize());
+        m_VSUniforms.CopyFrom(m_Material->m_VSUniforms);
     }
 
     if (m_Material->GetShader()->HasPSMaterialUniformBuffer())
     {
-        const auto& psBuffer = m_Material->GetShader()->GetPSMaterialUniformBuffer();
-        m_PSUniformStorageBuffer.Allocate(psBuffer.GetSize());
-        m_PSUniformStorageBuffer.Write(m_Material->GetPSUniformStorageBuffer().Data, psBuffer.GetSize());
+        m_PSUniforms.Allocate(m_Material->GetShader()->GetPSMaterialUniformBuffer().GetSize());
+        m_PSUniforms.CopyFrom(m_Material->m_PSUniforms);
     }
+
+    m_OverriddenUniforms = 0;
+    m_SyncedVersion = m_Material->m_Version;
+}
+
+void MaterialInstance::SetKeywordEnabled(const std::string& keyword, bool enabled)
+{
+    uint32_t mask = m_Material->GetShader()->GetKeywordMask(keyword);
+    enabled ? m_DisabledKeywords &= ~mask : m_DisabledKeywords |= mask;
+}
+
+bool MaterialInstance::IsKeywordEnabled(const std::string& keyword) const
+{
+    return GetEnabledKeywords() & m_Material->m_Shader->GetKeywordMask(keyword);
 }
 
 void MaterialInstance::BindTextures() const
@@ -196,38 +300,51 @@ void MaterialInstance::BindTextures() const
     }
 }
 
-Buffer& MaterialInstance::GetUniformBufferTarget(ShaderUniform* uniform)
+MaterialUniformBlock& MaterialInstance::GetUniformBlockTarget(ShaderUniform* uniform)
 {
     switch (uniform->GetDomain())
     {
-        case ShaderDomain::Vertex:  return m_VSUniformStorageBuffer;
-        case ShaderDomain::Pixel:   return m_PSUniformStorageBuffer;
+        case ShaderDomain::Vertex:  return m_VSUniforms;
+        case ShaderDomain::Pixel:   return m_PSUniforms;
     }
 
     AB_CORE_ASSERT(false, "Invalid shader domain! Material does not support this shader type.");
-    return m_VSUniformStorageBuffer;
+    return m_VSUniforms;
 }
 
-const Buffer& MaterialInstance::GetUniformBufferTarget(ShaderUniform* uniform) const
+const MaterialUniformBlock& MaterialInstance::GetUniformBlockTarget(ShaderUniform* uniform) const
 {
     switch (uniform->GetDomain())
     {
-        case ShaderDomain::Vertex:  return m_VSUniformStorageBuffer;
-        case ShaderDomain::Pixel:   return m_PSUniformStorageBuffer;
+        case ShaderDomain::Vertex:  return m_VSUniforms;
+        case ShaderDomain::Pixel:   return m_PSUniforms;
     }
 
     AB_CORE_ASSERT(false, "Invalid shader domain! Material does not support this shader type.");
-    return m_VSUniformStorageBuffer;
+    return m_VSUniforms;
 }
 
-void MaterialInstance::OnMaterialValueUpdated(ShaderUniform* uniform)
+void MaterialInstance::SyncWithMaterial()
 {
-    if (m_OverriddenValues.find(uniform->GetName()) == m_OverriddenValues.end())
-    {
-        auto& buffer = GetUniformBufferTarget(uniform);
-        auto& materialBuffer = m_Material->GetUniformBufferTarget(uniform);
-        buffer.Write(materialBuffer.Data + uniform->GetOffset(), uniform->GetSize(), uniform->GetOffset());
-    }
+    if (m_SyncedVersion == m_Material->m_Version)
+        return;
+
+    auto shader = m_Material->GetShader();
+    auto sync = [this](const ShaderUniformBuffer& uniformBuffer) {
+        for (auto uniform : uniformBuffer.GetUniforms())
+        {
+            if (!IsOverridden(uniform) && m_Material->m_UniformVersions[uniform->GetIndex()] > m_SyncedVersion)
+                GetUniformBlockTarget(uniform).CopyUniform(uniform, m_Material->GetUniformBlockTarget(uniform));
+        }
+    };
+
+    if (m_VSUniforms)
+        sync(shader->GetVSMaterialUniformBuffer());
+
+    if (m_PSUniforms)
+        sync(shader->GetPSMaterialUniformBuffer());
+
+    m_SyncedVersion = m_Material->m_Version;
 }
 
 }
\ No newline at end of file
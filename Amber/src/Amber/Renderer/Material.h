@@ -4,9 +4,11 @@
 
 #include "Amber/Core/Base.h"
 #include "Amber/Core/Buffer.h"
+#include "Amber/Core/Hash.h"
 
 #include "Amber/Renderer/Shader.h"
 #include "Amber/Renderer/Texture.h"
+#include "Amber/Renderer/UniformBuffer.h"
 
 namespace Amber
 {
@@ -19,6 +21,44 @@ enum class MaterialFlag
     Blend       = BIT(3)
 };
 
+// Handle to a material uniform or texture by the hash of its name. Declare handles for names set on
+// hot paths as constexpr so the hash is computed at compile time, strings still convert for tools and scripts.
+struct MaterialProperty
+{
+    uint32_t NameHash;
+
+    constexpr MaterialProperty(const char* name)
+        : NameHash(Hash::FNV(name)) {}
+    MaterialProperty(const std::string& name)
+        : NameHash(Hash::FNV(name)) {}
+};
+
+// CPU copy of one std140 material block. Writes widen a dirty range that is uploaded to the
+// block's own uniform buffer on the next bind, unchanged blocks are only rebound.
+class MaterialUniformBlock
+{
+public:
+    void Allocate(uint32_t size);
+    void Clear();
+
+    // Returns false when the block already held the value
+    bool Write(const ShaderUniform* uniform, const void* value);
+    void Read(const ShaderUniform* uniform, void* value) const;
+    void CopyUniform(const ShaderUniform* uniform, const MaterialUniformBlock& source);
+    void CopyFrom(const MaterialUniformBlock& source);
+
+    void Bind(uint32_t binding);
+
+    operator bool() const { return m_Data; }
+
+private:
+    Buffer m_Data;
+    Ref<UniformBuffer> m_UniformBuffer;
+    uint32_t m_DirtyBegin = 0, m_DirtyEnd = 0;
+
+    void MarkDirty(uint32_t offset, uint32_t size);
+};
+
 class Material : public RefCounted
 {
     friend class MaterialInstance;
@@ -29,6 +69,8 @@ public:
 
     void Bind();
     void Reset(Ref<Shader> shader = nullptr);
+    // Whether the shader variant Bind would use has finished compiling, see Shader::IsReady
+    bool IsReady() const { return GetVariant(m_TextureKeywords)->IsReady(); }
 
     Ref<Shader> GetShader() { return m_Shader; }
 
@@ -36,55 +78,55 @@ public:
     void SetFlag(MaterialFlag flag, bool value = true) { value ? m_Flags |= (uint32_t)flag : m_Flags &= ~(uint32_t)flag; }
 
     template<typename T>
-    void Set(const std::string& name, const T& value)
+    void Set(MaterialProperty property, const T& value)
     {
-        auto uniform = FindUniform(name);
+        auto uniform = FindUniform(property);
         AB_CORE_ASSERT(uniform, "Could not find uniform!");
 
-        auto& buffer = GetUniformBufferTarget(uniform);
-        buffer.Write((byte*)&value, uniform->GetSize(), uniform->GetOffset());
-
-        for (auto instance : m_MaterialInstances)
-            instance->OnMaterialValueUpdated(uniform);
+        // Unchanged values keep their version so instances don't copy and upload them again
+        if (GetUniformBlockTarget(uniform).Write(uniform, &value))
+            m_UniformVersions[uniform->GetIndex()] = ++m_Version;
     }
 
-    void Set(const std::string& name, const Ref<Texture>& texture)
+    void Set(MaterialProperty property, const Ref<Texture>& texture)
     {
-        auto resource = FindResource(name);
+        auto resource = FindResource(property);
         AB_CORE_ASSERT(resource, "Could not find texture!");
 
         uint32_t slot = resource->GetRegister();
         if (m_Textures.size() <= slot)
             m_Textures.resize((size_t)slot + 1);
         m_Textures[slot] = texture;
+
+        uint32_t keyword = resource->GetKeyword();
+        texture ? m_TextureKeywords |= keyword : m_TextureKeywords &= ~keyword;
     }
 
-    void Set(const std::string& name, const Ref<Texture2D>& texture)
+    void Set(MaterialProperty property, const Ref<Texture2D>& texture)
     {
-        Set(name, (const Ref<Texture>&)texture);
+        Set(property, (const Ref<Texture>&)texture);
     }
 
-    void Set(const std::string& name, const Ref<TextureCube>& texture)
+    void Set(MaterialProperty property, const Ref<TextureCube>& texture)
     {
-        Set(name, (const Ref<Texture>&)texture);
+        Set(property, (const Ref<Texture>&)texture);
     }
 
     template<typename T>
-    T Get(const std::string& name) const
+    T Get(MaterialProperty property) const
     {
-        auto uniform = FindUniform(name);
+        auto uniform = FindUniform(property);
         AB_CORE_ASSERT(uniform, "Could not find uniform!");
 
-        const auto& buffer = GetUniformBufferTarget(uniform);
         T dest;
-        buffer.Read(&dest, uniform->GetSize(), uniform->GetOffset());
+        GetUniformBlockTarget(uniform).Read(uniform, &dest);
 
         return dest;
     }
 
-    Ref<Texture> GetResource(const std::string& name) const
+    Ref<Texture> GetResource(MaterialProperty property) const
     {
-        auto resource = FindResource(name);
+        auto resource = FindResource(property);
         AB_CORE_ASSERT(resource, "Could not find texture!");
 
         uint32_t slot = resource->GetRegister();
@@ -99,24 +141,27 @@ private:
     Ref<Shader> m_Shader;
     std::vector<Ref<Texture>> m_Textures;
 
-    Buffer m_VSUniformStorageBuffer;
-    Buffer m_PSUniformStorageBuffer;
+    MaterialUniformBlock m_VSUniforms;
+    MaterialUniformBlock m_PSUniforms;
+
+    // Instances compare these against the version they last synced to when they are bound
+    std::vector<uint64_t> m_UniformVersions;
+    uint64_t m_Version = 0;
+
+    // Keywords of the textures that are set, they pick the shader variant that is bound
+    uint32_t m_TextureKeywords = 0;
 
     uint32_t m_Flags;
 
     void AllocateStorage();
     void BindTextures() const;
+    Ref<Shader> GetVariant(uint32_t keywords) const;
 
-    ShaderUniform* FindUniform(const std::string& name) const;
-    ShaderResource* FindResource(const std::string& name) const;
+    ShaderUniform* FindUniform(MaterialProperty property) const;
+    ShaderResource* FindResource(MaterialProperty property) const;
 
-    Buffer& GetVSUniformStorageBuffer() { return m_VSUniformStorageBuffer; }
-    Buffer& GetPSUniformStorageBuffer() { return m_PSUniformStorageBuffer; }
-    Buffer& GetUniformBufferTarget(ShaderUniform* uniform);
-
-    const Buffer& GetVSUniformStorageBuffer() const { return m_VSUniformStorageBuffer; }
-    const Buffer& GetPSUniformStorageBuffer() const { return m_PSUniformStorageBuffer; }
-    const Buffer& GetUniformBufferTarget(ShaderUniform* uniform) const;
+    MaterialUniformBlock& GetUniformBlockTarget(ShaderUniform* uniform);
+    const MaterialUniformBlock& GetUniformBlockTarget(ShaderUniform* uniform) const;
 
     void AddMaterialInstance(MaterialInstance* materialInstance) { m_MaterialInstances.insert(materialInstance); }
     void RemoveMaterialInstance(MaterialInstance* materialInstance) { m_MaterialInstances.erase(materialInstance); }
@@ -129,6 +174,7 @@ public:
     ~MaterialInstance();
 
     void Bind();
+    bool IsReady() const { return m_Material->GetVariant(GetEnabledKeywords())->IsReady(); }
 
     Ref<Shader> GetShader() { return m_Material->GetShader(); }
 
@@ -137,54 +183,58 @@ public:
     void SetFlag(MaterialFlag flag, bool value = true) { m_Material->SetFlag(flag, value); }
 
     template<typename T>
-    void Set(const std::string& name, const T& value)
+    void Set(MaterialProperty property, const T& value)
     {
-        auto uniform = m_Material->FindUniform(name);
+        auto uniform = m_Material->FindUniform(property);
         AB_CORE_ASSERT(uniform, "Could not find uniform!");
 
-        auto& buffer = GetUniformBufferTarget(uniform);
-        buffer.Write((byte*)&value, uniform->GetSize(), uniform->GetOffset());
-
-        m_OverriddenValues.insert(name);
+        GetUniformBlockTarget(uniform).Write(uniform, &value);
+        m_OverriddenUniforms |= 1ull << uniform->GetIndex();
     }
 
-    void Set(const std::string& name, const Ref<Texture>& texture)
+    void Set(MaterialProperty property, const Ref<Texture>& texture)
     {
-        auto resource = m_Material->FindResource(name);
+        auto resource = m_Material->FindResource(property);
         AB_CORE_ASSERT(resource, "Could not find texture!");
 
         uint32_t slot = resource->GetRegister();
         if (m_Textures.size() <= slot)
             m_Textures.resize((size_t)slot + 1);
         m_Textures[slot] = texture;
+
+        uint32_t keyword = resource->GetKeyword();
+        texture ? m_TextureKeywords |= keyword : m_TextureKeywords &= ~keyword;
     }
 
-    void Set(const std::string& name, const Ref<Texture2D>& texture)
+    void Set(MaterialProperty property, const Ref<Texture2D>& texture)
     {
-        Set(name, (const Ref<Texture>&)texture);
+        Set(property, (const Ref<Texture>&)texture);
     }
 
-    void Set(const std::string& name, const Ref<TextureCube>& texture)
+    void Set(MaterialProperty property, const Ref<TextureCube>& texture)
     {
-        Set(name, (const Ref<Texture>&)texture);
+        Set(property, (const Ref<Texture>&)texture);
     }
 
     template<typename T>
-    T Get(const std::string& name) const
+    T Get(MaterialProperty property) const
     {
-        auto uniform = m_Material->FindUniform(name);
+        auto uniform = m_Material->FindUniform(property);
         AB_CORE_ASSERT(uniform, "Could not find uniform!");
 
-        const auto& buffer = GetUniformBufferTarget(uniform);
+        // Inherited values are only synced on bind, read them from the material
         T dest;
-        buffer.Read(&dest, uniform->GetSize(), uniform->GetOffset());
+        if (IsOverridden(uniform))
+            GetUniformBlockTarget(uniform).Read(uniform, &dest);
+        else
+            m_Material->GetUniformBlockTarget(uniform).Read(uniform, &dest);
 
         return dest;
     }
 
-    Ref<Texture> Get(const std::string& name) const
+    Ref<Texture> Get(MaterialProperty property) const
     {
-        auto resource = m_Material->FindResource(name);
+        auto resource = m_Material->FindResource(property);
         AB_CORE_ASSERT(resource, "Could not find texture!");
 
         uint32_t slot = resource->GetRegister();
@@ -193,6 +243,10 @@ public:
         return m_Textures[slot];
     }
 
+    // Keeps a texture keyword off while its texture stays set, so a map can be switched off and back on
+    void SetKeywordEnabled(const std::string& keyword, bool enabled);
+    bool IsKeywordEnabled(const std::string& keyword) const;
+
     const std::string& GetName() const { return m_Name; }
 
 private:
@@ -201,18 +255,24 @@ private:
 
     std::vector<Ref<Texture>> m_Textures;
 
-    Buffer m_VSUniformStorageBuffer;
-    Buffer m_PSUniformStorageBuffer;
+    MaterialUniformBlock m_VSUniforms;
+    MaterialUniformBlock m_PSUniforms;
+
+    uint64_t m_OverriddenUniforms = 0;
+    uint64_t m_SyncedVersion = 0;
 
-    std::unordered_set<std::string> m_OverriddenValues;
+    uint32_t m_TextureKeywords = 0;
+    uint32_t m_DisabledKeywords = 0;
 
     void AllocateStorage();
     void BindTextures() const;
+    void SyncWithMaterial();
+    uint32_t GetEnabledKeywords() const { return (m_Material->m_TextureKeywords | m_TextureKeywords) & ~m_DisabledKeywords; }
 
-    Buffer& GetUniformBufferTarget(ShaderUniform* uniform);
-    const Buffer& GetUniformBufferTarget(ShaderUniform* uniform) const;
+    bool IsOverridden(const ShaderUniform* uniform) const { return m_OverriddenUniforms & (1ull << uniform->GetIndex()); }
 
-    void OnMaterialValueUpdated(ShaderUniform* uniform);
+    MaterialUniformBlock& GetUniformBlockTarget(ShaderUniform* uniform);
+    const MaterialUniformBlock& GetUniformBlockTarget(ShaderUniform* uniform) const;
 
     friend class Material;
 };
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Amber/Renderer/Material.h"
+
+namespace Amber
+{
+
+// Uniforms the renderers set for every draw, hashed at compile time
+namespace MaterialProperties
+{
+
+constexpr MaterialProperty Transform = "u_Transform";
+constexpr MaterialProperty NormalTransform = "u_NormalTransform";
+constexpr MaterialProperty ObjectIndex = "u_ObjectIndex";
+constexpr MaterialProperty SubmeshIndex = "u_SubmeshIndex";
+constexpr MaterialProperty BoneTransform = "u_BoneTransform";
+
+}
+
+}
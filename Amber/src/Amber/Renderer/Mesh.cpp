@@ -11,6 +11,7 @@
 
 #include <glm/gtx/quaternion.hpp>
 
+#include "Amber/Renderer/MeshSimplifier.h"
 #include "Amber/Renderer/Renderer.h"
 #include "Amber/Renderer/Texture.h"
 
@@ -79,8 +80,8 @@ static std::string GetTexturePath(const std::string& curPath, const aiString& te
     return GetTexturePath(curPath, texturePath.data);
 }
 
-Mesh::Mesh(const std::string& filepath)
-    : m_AssetPath(filepath)
+Mesh::Mesh(const std::string& filepath, const MeshLODSettings& lodSettings)
+    : m_AssetPath(filepath), m_LODSettings(lodSettings)
 {
     LogStream::Initialize();
 
@@ -230,6 +231,24 @@ Mesh::Mesh(const std::string& filepath)
 
     TraverseNodes(m_Scene->mRootNode);
 
+    for (auto& submesh : m_Submeshes)
+    {
+        const auto& aabb = submesh.BoundingBox;
+        if (aabb.Min.x > aabb.Max.x)
+            continue;
+
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            glm::vec3 corner(i & 1 ? aabb.Max.x : aabb.Min.x, i & 2 ? aabb.Max.y : aabb.Min.y, i & 4 ? aabb.Max.z : aabb.Min.z);
+            corner = submesh.Transform * glm::vec4(corner, 1.0f);
+            m_BoundingBox.Min = glm::min(m_BoundingBox.Min, corner);
+            m_BoundingBox.Max = glm::max(m_BoundingBox.Max, corner);
+        }
+    }
+
+    GenerateLODs();
+    CreateSubmeshTransformBuffer();
+
     VertexBufferLayout vertexBufferLayout;
     if (m_IsAnimated)
     {
@@ -298,6 +317,8 @@ void Mesh::Bind()
     m_VertexBuffer->Bind();
     m_Pipeline->Bind();
     m_IndexBuffer->Bind();
+    if (m_SubmeshTransformBuffer)
+        m_SubmeshTransformBuffer->Bind(SubmeshTransformBinding);
 }
 
 void Mesh::OnUpdate(Timestep ts)
@@ -367,28 +388,28 @@ bool Mesh::UsingAlbedoTexture(Submesh& submesh) const
 {
     uint32_t index = submesh.MaterialIndex;
     auto& materialInstance = m_Materials[index];
-    return materialInstance->Get<uint32_t>("u_AlbedoTexToggle");
+    return materialInstance->IsKeywordEnabled("ALBEDO_MAP");
 }
 
 bool Mesh::UsingNormalTexture(Submesh& submesh) const
 {
     uint32_t index = submesh.MaterialIndex;
     auto& materialInstance = m_Materials[index];
-    return materialInstance->Get<uint32_t>("u_NormalTexToggle");
+    return materialInstance->IsKeywordEnabled("NORMAL_MAP");
 }
 
 bool Mesh::UsingRoughnessTexture(Submesh& submesh) const
 {
     uint32_t index = submesh.MaterialIndex;
     auto& materialInstance = m_Materials[index];
-    return materialInstance->Get<uint32_t>("u_RoughnessTexToggle");
+    return materialInstance->IsKeywordEnabled("ROUGHNESS_MAP");
 }
 
 bool Mesh::UsingMetalnessTexture(Submesh& submesh) const
 {
     uint32_t index = submesh.MaterialIndex;
     auto& materialInstance = m_Materials[index];
-    return materialInstance->Get<uint32_t>("u_MetalnessTexToggle");
+    return materialInstance->IsKeywordEnabled("METALNESS_MAP");
 }
 
 void Mesh::SetAlbedo(Submesh& submesh, const glm::vec3& albedo)
@@ -424,9 +445,7 @@ void Mesh::SetAlbedoTexture(Submesh& submesh, bool use, Ref<Texture2D> albedo)
         materialInstance->Set("u_AlbedoTexture", albedo);
         submesh.HasAlbedoMap = true;
     }
-    if (m_BaseMaterial->GetShader()->GetType() == ShaderType::StandardStatic ||
-        m_BaseMaterial->GetShader()->GetType() == ShaderType::StandardAnimated)
-        materialInstance->Set("u_AlbedoTexToggle", (uint32_t)(use && submesh.HasAlbedoMap));
+    materialInstance->SetKeywordEnabled("ALBEDO_MAP", use);
 }
 
 void Mesh::SetNormalTexture(Submesh& submesh, bool use, Ref<Texture2D> normal)
@@ -438,7 +457,7 @@ void Mesh::SetNormalTexture(Submesh& submesh, bool use, Ref<Texture2D> normal)
         materialInstance->Set("u_NormalTexture", normal);
         submesh.HasNormalMap = true;
     }
-    materialInstance->Set("u_NormalTexToggle", (uint32_t)(use && submesh.HasNormalMap));
+    materialInstance->SetKeywordEnabled("NORMAL_MAP", use);
 }
 
 void Mesh::SetRoughnessTexture(Submesh& submesh, bool use, Ref<Texture2D> roughness)
@@ -450,7 +469,7 @@ void Mesh::SetRoughnessTexture(Submesh& submesh, bool use, Ref<Texture2D> roughn
         materialInstance->Set("u_RoughnessTexture", roughness);
         submesh.HasRoughnessMap = true;
     }
-    materialInstance->Set("u_RoughnessTexToggle", (uint32_t)(use && submesh.HasRoughnessMap));
+    materialInstance->SetKeywordEnabled("ROUGHNESS_MAP", use);
 }
 
 void Mesh::SetMetalnessTexture(Submesh& submesh, bool use, Ref<Texture2D> metalness)
@@ -462,7 +481,7 @@ void Mesh::SetMetalnessTexture(Submesh& submesh, bool use, Ref<Texture2D> metaln
         materialInstance->Set("u_MetalnessTexture", metalness);
         submesh.HasMetalnessMap = true;
     }
-    materialInstance->Set("u_MetalnessTexToggle", (uint32_t)(use && submesh.HasMetalnessMap));
+    materialInstance->SetKeywordEnabled("METALNESS_MAP", use);
 }
 
 void Mesh::SetMaterial(aiMaterial* material, uint32_t index, Submesh* submesh)
@@ -502,7 +521,6 @@ void Mesh::SetMaterial(aiMaterial* material, uint32_t index, Submesh* submesh)
         {
             m_Textures[index] = albedo;
             materialInstance->Set("u_AlbedoTexture", albedo);
-            materialInstance->Set("u_AlbedoTexToggle", 1);
             if (submesh)
                 submesh->HasAlbedoMap = true;
         }
@@ -528,7 +546,6 @@ void Mesh::SetMaterial(aiMaterial* material, uint32_t index, Submesh* submesh)
         if (normalMap->Loaded())
         {
             materialInstance->Set("u_NormalTexture", normalMap);
-            materialInstance->Set("u_NormalTexToggle", 1);
             if (submesh)
                 submesh->HasNormalMap = true;
         }
@@ -551,7 +568,6 @@ void Mesh::SetMaterial(aiMaterial* material, uint32_t index, Submesh* submesh)
         if (roughnessMap->Loaded())
         {
             materialInstance->Set("u_RoughnessTexture", roughnessMap);
-            materialInstance->Set("u_RoughnessTexToggle", 1);
             if (submesh)
                 submesh->HasRoughnessMap = true;
         }
@@ -639,7 +655,6 @@ void Mesh::SetMaterial(aiMaterial* material, uint32_t index, Submesh* submesh)
             if (metalnessMap->Loaded())
             {
                 materialInstance->Set("u_MetalnessTexture", metalnessMap);
-                materialInstance->Set("u_MetalnessTexToggle", 1);
                 if (submesh)
                     submesh->HasMetalnessMap = true;
             }
@@ -674,6 +689,72 @@ void Mesh::TraverseNodes(aiNode* node, const glm::mat4& parentTransform)
         TraverseNodes(node->mChildren[i], transform);
 }
 
+void Mesh::CreateSubmeshTransformBuffer()
+{
+    if (m_Submeshes.empty())
+        return;
+
+    // Submesh transforms are fixed after import, so their normal matrices are computed once here
+    std::vector<SubmeshTransform> transforms(m_Submeshes.size());
+    for (size_t i = 0; i < m_Submeshes.size(); i++)
+    {
+        transforms[i].Transform = m_Submeshes[i].Transform;
+        transforms[i].NormalTransform = glm::mat4(glm::transpose(glm::inverse(glm::mat3(m_Submeshes[i].Transform))));
+    }
+
+    m_SubmeshTransformBuffer = StorageBuffer::Create(sizeof(SubmeshTransform) * transforms.size());
+    m_SubmeshTransformBuffer->SetData(transforms.data(), sizeof(SubmeshTransform) * transforms.size());
+}
+
+void Mesh::GenerateLODs()
+{
+    for (auto& submesh : m_Submeshes)
+    {
+        std::vector<Index> indices(m_Indices.begin() + submesh.BaseIndex / 3, m_Indices.begin() + (submesh.BaseIndex + submesh.IndexCount) / 3);
+
+        uint32_t vertexCount = 0;
+        for (auto& index : indices)
+            vertexCount = glm::max(vertexCount, glm::max(index.V0, glm::max(index.V1, index.V2)) + 1);
+
+        std::vector<glm::vec3> positions(vertexCount);
+        glm::vec3 min(std::numeric_limits<float>::max()), max(-std::numeric_limits<float>::max());
+        for (uint32_t i = 0; i < vertexCount; i++)
+        {
+            positions[i] = m_IsAnimated ? m_AnimatedVertices[submesh.BaseVertex + i].Position : m_StaticVertices[submesh.BaseVertex + i].Position;
+            min = glm::min(min, positions[i]);
+            max = glm::max(max, positions[i]);
+        }
+
+        float maxError = m_LODSettings.MaxError * glm::length(max - min);
+        for (uint32_t lod = 0; lod < m_LODSettings.Count; lod++)
+        {
+            uint32_t targetIndexCount = (uint32_t)(indices.size() * m_LODSettings.Reduction) * 3;
+            auto simplified = MeshSimplifier::Simplify(positions, indices, targetIndexCount, maxError);
+
+            // Not worth a level if the error budget barely allowed any collapses
+            if (simplified.empty() || simplified.size() > indices.size() * 0.9f)
+                break;
+
+            submesh.LODs.push_back({ (uint32_t)m_Indices.size() * 3, (uint32_t)simplified.size() * 3 });
+            m_Indices.insert(m_Indices.end(), simplified.begin(), simplified.end());
+            indices = std::move(simplified);
+        }
+
+        m_LODCount = glm::max(m_LODCount, (uint32_t)submesh.LODs.size() + 1);
+    }
+
+    AB_MESH_LOG("Generated {} levels of detail", m_LODCount);
+}
+
+float Mesh::GetLODScreenSize(uint32_t lod) const
+{
+    if (lod == 0)
+        return std::numeric_limits<float>::max();
+
+    // Each level has Reduction times the triangles, so its projected area can shrink by the same factor
+    return m_LODSettings.ScreenSize * glm::pow(glm::sqrt(m_LODSettings.Reduction), (float)(lod - 1));
+}
+
 void Mesh::UpdateBones(float time)
 {
     TraverseNodeHierarchy(m_AnimationTime, m_Scene->mRootNode);
@@ -13,6 +13,7 @@
 #include "Amber/Renderer/Material.h"
 #include "Amber/Renderer/Pipeline.h"
 #include "Amber/Renderer/Shader.h"
+#include "Amber/Renderer/StorageBuffer.h"
 #include "Amber/Renderer/Texture.h"
 #include "Amber/Renderer/VertexBuffer.h"
 
@@ -91,6 +92,12 @@ struct Triangle
         : V0(v0), V1(v1), V2(v2) {}
 };
 
+struct SubmeshLOD
+{
+    uint32_t BaseIndex;
+    uint32_t IndexCount;
+};
+
 struct Submesh : public RefCounted
 {
     uint32_t BaseVertex;
@@ -106,16 +113,39 @@ struct Submesh : public RefCounted
     glm::mat4 Transform = glm::mat4(1.0f);
     Math::AABB BoundingBox;
 
+    // Coarser levels of detail, sharing the mesh's vertices. LOD 0 is BaseIndex/IndexCount
+    std::vector<SubmeshLOD> LODs;
+
     Submesh() = default;
     Submesh(uint32_t baseVertex, uint32_t baseIndex, uint32_t indexCount, uint32_t materialIndex)
         : BaseVertex(baseVertex), BaseIndex(baseIndex), IndexCount(indexCount), MaterialIndex(materialIndex) {}
 };
 
+struct MeshLODSettings
+{
+    // Levels generated below full detail, each aiming for Reduction times the previous triangle count
+    uint32_t Count = 3;
+    float Reduction = 0.5f;
+    // Largest surface deviation allowed, relative to the mesh's bounding box diagonal
+    float MaxError = 0.02f;
+    // Projected bounding sphere diameter, as a fraction of screen height, below which LOD 1 is used
+    float ScreenSize = 0.5f;
+};
+
 class Mesh : public RefCounted
 {
 public:
+    static constexpr uint32_t SubmeshTransformBinding = 1;
+
+    // Matches SubmeshTransform in the standard shaders, std430
+    struct SubmeshTransform
+    {
+        glm::mat4 Transform;
+        glm::mat4 NormalTransform;
+    };
+
     Mesh() = default;
-    Mesh(const std::string& filepath);
+    Mesh(const std::string& filepath, const MeshLODSettings& lodSettings = {});
     ~Mesh();
 
     void Bind();
@@ -125,6 +155,14 @@ public:
     const std::vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
     const std::vector<Triangle>& GetTriangleCache(uint32_t index) { return m_TriangleCache[index]; }
 
+    // Bind pose bounds in mesh space, submesh transforms included
+    const Math::AABB& GetBoundingBox() const { return m_BoundingBox; }
+
+    uint32_t GetLODCount() const { return m_LODCount; }
+    const MeshLODSettings& GetLODSettings() const { return m_LODSettings; }
+    // Screen size below which the given LOD is selected
+    float GetLODScreenSize(uint32_t lod) const;
+
     const std::string& GetAssetPath() const { return m_AssetPath; }
     Ref<Material> GetMaterial() { return m_BaseMaterial; }
     Ref<Material> GetMaterial() const { return m_BaseMaterial; }
@@ -176,12 +214,17 @@ private:
     std::vector<Submesh> m_Submeshes;
     std::unordered_map<uint32_t, std::vector<Triangle>> m_TriangleCache;
 
+    Math::AABB m_BoundingBox;
+    MeshLODSettings m_LODSettings;
+    uint32_t m_LODCount = 1;
+
     std::vector<AnimatedVertex> m_AnimatedVertices;
     std::vector<StaticVertex> m_StaticVertices;
     std::vector<Index> m_Indices;
     Ref<VertexBuffer> m_VertexBuffer;
     Ref<Pipeline> m_Pipeline;
     Ref<IndexBuffer> m_IndexBuffer;
+    Ref<StorageBuffer> m_SubmeshTransformBuffer;
 
     glm::mat4 m_InverseRootTransform = glm::mat4(1.0f);
 
@@ -204,6 +247,8 @@ private:
     void SetMaterial(aiMaterial* material, uint32_t index, Submesh* submesh = nullptr);
 
     void TraverseNodes(aiNode* node, const glm::mat4& parentTransform = glm::mat4(1.0f));
+    void GenerateLODs();
+    void CreateSubmeshTransformBuffer();
 
     void UpdateBones(float time);
     void TraverseNodeHierarchy(float time, const aiNode* node, const glm::mat4& parentTransform = glm::mat4(1.0f));
@@ -218,6 +263,7 @@ private:
     glm::vec3 InterpolateScale(float time, const aiNodeAnim* nodeAnim);
 
     friend class MeshFactory;
+    friend class StaticMeshBatch;
 };
 
 }
\ No newline at end of file
@@ -77,6 +77,8 @@ Ref<Mesh> MeshFactory::Plane(float width, float height)
     Ref<MaterialInstance> material = Ref<MaterialInstance>::Create(mesh->m_BaseMaterial);
     mesh->m_Materials.push_back(material);
 
+    mesh->CreateSubmeshTransformBuffer();
+
     return mesh;
 }
 
@@ -170,6 +172,8 @@ Ref<Mesh> MeshFactory::Cube(const glm::vec3& center, float length)
     material->Set("u_Metalness", 0.0f);
     mesh->m_Materials.push_back(material);
 
+    mesh->CreateSubmeshTransformBuffer();
+
     return mesh;
 }
 
@@ -252,6 +256,8 @@ Ref<Mesh> MeshFactory::Sphere(const glm::vec3& center, float radius)
     material->Set("u_Metalness", 0.0f);
     mesh->m_Materials.push_back(material);
 
+    mesh->CreateSubmeshTransformBuffer();
+
     return mesh;
 }
 
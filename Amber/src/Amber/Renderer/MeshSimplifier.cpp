@@ -0,0 +1,187 @@
+#include "abpch.h"
+#include "MeshSimplifier.h"
+
+#include <cfloat>
+#include <map>
+#include <queue>
+
+#include "Amber/Renderer/Mesh.h"
+
+namespace Amber
+{
+
+struct EdgeCollapse
+{
+    double Cost;
+    uint32_t From, To;
+    uint32_t FromVersion, ToVersion;
+
+    bool operator>(const EdgeCollapse& other) const { return Cost > other.Cost; }
+};
+
+static glm::dvec3 TriangleNormal(const glm::dvec3& v0, const glm::dvec3& v1, const glm::dvec3& v2)
+{
+    return glm::cross(v1 - v0, v2 - v0);
+}
+
+std::vector<Index> MeshSimplifier::Simplify(const std::vector<glm::vec3>& positions, const std::vector<Index>& indices, uint32_t targetIndexCount, float maxError)
+{
+    uint32_t vertexCount = (uint32_t)positions.size();
+    uint32_t triangleCount = (uint32_t)indices.size();
+
+    std::vector<std::array<uint32_t, 3>> triangles(triangleCount);
+    std::vector<bool> removed(triangleCount, false);
+    std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+    std::vector<glm::dmat4> quadrics(vertexCount, glm::dmat4(0.0));
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> edgeUse;
+
+    for (uint32_t t = 0; t < triangleCount; t++)
+    {
+        triangles[t] = { indices[t].V0, indices[t].V1, indices[t].V2 };
+
+        glm::dvec3 v0 = positions[indices[t].V0], v1 = positions[indices[t].V1], v2 = positions[indices[t].V2];
+        glm::dvec3 normal = TriangleNormal(v0, v1, v2);
+        double length = glm::length(normal);
+        if (length > 0.0)
+        {
+            // Fundamental error quadric of the triangle's plane
+            glm::dvec4 plane(normal / length, -glm::dot(normal / length, v0));
+            glm::dmat4 quadric = glm::outerProduct(plane, plane);
+            for (uint32_t vertex : triangles[t])
+                quadrics[vertex] += quadric;
+        }
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            uint32_t a = triangles[t][i], b = triangles[t][(i + 1) % 3];
+            vertexTriangles[a].push_back(t);
+            edgeUse[{ glm::min(a, b), glm::max(a, b) }]++;
+        }
+    }
+
+    // Open borders and attribute seams (split vertices) are kept in place
+    std::vector<bool> locked(vertexCount, false);
+    for (auto& [edge, count] : edgeUse)
+    {
+        if (count == 1)
+            locked[edge.first] = locked[edge.second] = true;
+    }
+
+    std::vector<uint32_t> versions(vertexCount, 0);
+    std::priority_queue<EdgeCollapse, std::vector<EdgeCollapse>, std::greater<EdgeCollapse>> queue;
+
+    auto collapseCost = [&](uint32_t from, uint32_t to) {
+        glm::dvec4 v(glm::dvec3(positions[to]), 1.0);
+        return glm::dot(v, (quadrics[from] + quadrics[to]) * v);
+    };
+
+    auto pushEdge = [&](uint32_t a, uint32_t b) {
+        double costAB = locked[a] ? DBL_MAX : collapseCost(a, b);
+        double costBA = locked[b] ? DBL_MAX : collapseCost(b, a);
+        if (costAB == DBL_MAX && costBA == DBL_MAX)
+            return;
+
+        if (costAB <= costBA)
+            queue.push({ costAB, a, b, versions[a], versions[b] });
+        else
+            queue.push({ costBA, b, a, versions[b], versions[a] });
+    };
+
+    for (auto& [edge, count] : edgeUse)
+        pushEdge(edge.first, edge.second);
+
+    double maxCost = (double)maxError * maxError;
+    uint32_t liveTriangles = triangleCount;
+    while (!queue.empty() && liveTriangles * 3 > targetIndexCount)
+    {
+        EdgeCollapse collapse = queue.top();
+        queue.pop();
+
+        if (collapse.FromVersion != versions[collapse.From] || collapse.ToVersion != versions[collapse.To])
+            continue;
+        if (collapse.Cost > maxCost)
+            break;
+
+        uint32_t from = collapse.From, to = collapse.To;
+
+        // Reject collapses that would fold a remaining triangle over
+        bool flips = false;
+        for (uint32_t t : vertexTriangles[from])
+        {
+            if (removed[t])
+                continue;
+
+            auto& triangle = triangles[t];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                continue;
+
+            glm::dvec3 before[3], after[3];
+            for (uint32_t i = 0; i < 3; i++)
+            {
+                before[i] = positions[triangle[i]];
+                after[i] = positions[triangle[i] == from ? to : triangle[i]];
+            }
+
+            glm::dvec3 oldNormal = TriangleNormal(before[0], before[1], before[2]);
+            glm::dvec3 newNormal = TriangleNormal(after[0], after[1], after[2]);
+            if (glm::dot(oldNormal, newNormal) <= 0.0)
+            {
+                flips = true;
+                break;
+            }
+        }
+
+        if (flips)
+            continue;
+
+        for (uint32_t t : vertexTriangles[from])
+        {
+            if (removed[t])
+                continue;
+
+            auto& triangle = triangles[t];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+            {
+                removed[t] = true;
+                liveTriangles--;
+                continue;
+            }
+
+            for (auto& vertex : triangle)
+            {
+                if (vertex == from)
+                    vertex = to;
+            }
+            vertexTriangles[to].push_back(t);
+        }
+
+        vertexTriangles[from].clear();
+        quadrics[to] += quadrics[from];
+        versions[from]++;
+        versions[to]++;
+
+        for (uint32_t t : vertexTriangles[to])
+        {
+            if (removed[t])
+                continue;
+
+            for (uint32_t vertex : triangles[t])
+            {
+                if (vertex != to)
+                    pushEdge(to, vertex);
+            }
+        }
+    }
+
+    std::vector<Index> result;
+    result.reserve(liveTriangles);
+    for (uint32_t t = 0; t < triangleCount; t++)
+    {
+        if (!removed[t])
+            result.emplace_back(triangles[t][0], triangles[t][1], triangles[t][2]);
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Amber
+{
+
+struct Index;
+
+class MeshSimplifier
+{
+public:
+    // Quadric error edge collapse onto existing vertices, so the result indexes the same vertex buffer.
+    // Stops at targetIndexCount or once a collapse would move the surface by more than maxError (in mesh units).
+    static std::vector<Index> Simplify(const std::vector<glm::vec3>& positions, const std::vector<Index>& indices, uint32_t targetIndexCount, float maxError);
+};
+
+}
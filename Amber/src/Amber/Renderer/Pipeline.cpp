@@ -13,6 +13,7 @@ Ref<Pipeline> Pipeline::Create(const PipelineSpecification& spec)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLPipeline>::Create(spec);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Pipelines are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -2,6 +2,7 @@
 
 #include "Amber/Renderer/RenderCommandQueue.h"
 #include "Amber/Renderer/RendererAPI.h"
+#include "Amber/Renderer/StorageBuffer.h"
 
 namespace Amber 
 {
@@ -19,6 +20,7 @@ public:
     static void SetLineThickness(float thickness) { Submit([=]() { s_RendererAPI->SetLineThickness(thickness); }); }
     static void SetPointSize(float size) { Submit([=]() { s_RendererAPI->SetPointSize(size); }); }
     static void SetRasterizationMode(RasterizationMode mode) { Submit([=]() { s_RendererAPI->SetRasterizationMode(mode); }); }
+    static void SetDepthFunction(ComparisonFunc func) { Submit([=]() { s_RendererAPI->SetDepthFunction(func); }); }
     static void SetStencilFunction(ComparisonFunc func, uint8_t ref, uint8_t mask) 
     { 
         Submit([=]() { s_RendererAPI->SetStencilFunction(func, ref, mask); }); 
@@ -31,6 +33,18 @@ public:
         Submit([=]() { s_RendererAPI->SetStencilOperation(stencilFail, depthFail, depthPass); });
     }
 
+    static void Barrier(uint32_t barriers) { Submit([=]() { s_RendererAPI->Barrier(barriers); }); }
+
+    static void Dispatch(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1)
+    {
+        Submit([=]() { s_RendererAPI->Dispatch(groupsX, groupsY, groupsZ); });
+    }
+
+    static void DispatchIndirect(const Ref<StorageBuffer>& arguments, uint32_t offset = 0)
+    {
+        Submit([arguments, offset]() { s_RendererAPI->DispatchIndirect(arguments->GetRendererID(), offset); });
+    }
+
     static void DrawIndexed(uint32_t indexCount, PrimitiveType type, bool depthTest = true, bool stencilTest = false)
     { 
         Submit([=]() { s_RendererAPI->DrawIndexed(indexCount, type, depthTest, stencilTest); }); 
@@ -50,15 +64,34 @@ public:
             pFunc->~FuncT();
         };
 
-        auto storageBuffer = s_CommandQueue.Allocate(renderCmd, sizeof(func));
+        auto storageBuffer = GetActiveQueue().Allocate(renderCmd, sizeof(func));
         new (storageBuffer) FuncT(std::forward<FuncT>(func));
     }
 
+    // Copies data for a command about to be submitted, instead of capturing an owning buffer.
+    // The memory belongs to the queue being recorded and stays valid until that queue has executed.
+    static void* CopyPayload(const void* data, size_t size) { return GetActiveQueue().CopyData(data, size); }
+
+    // Redirects this thread's submissions into the queue, so worker threads can record work in parallel.
+    // Nothing runs until ExecuteQueue places the queue in the main one.
+    static void BeginRecording(RenderCommandQueue& queue) { s_RecordingQueue = &queue; }
+    static void EndRecording() { s_RecordingQueue = nullptr; }
+
+    // Recorded queues run at this point of the current one, in the order they are submitted.
+    // The command owns the queue, so it lives until it has been executed.
+    static void ExecuteQueue(Scope<RenderCommandQueue> queue)
+    {
+        Submit([recorded = std::move(queue)]() { recorded->Execute(); });
+    }
+
     static RenderCommandQueue& GetCommandQueue() { return s_CommandQueue; }
 
 private:
+    static RenderCommandQueue& GetActiveQueue() { return s_RecordingQueue ? *s_RecordingQueue : s_CommandQueue; }
+
     static Scope<RendererAPI> s_RendererAPI;
     inline static RenderCommandQueue s_CommandQueue;
+    inline static thread_local RenderCommandQueue* s_RecordingQueue = nullptr;
 };
 
 }
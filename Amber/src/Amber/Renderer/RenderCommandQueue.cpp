@@ -4,22 +4,26 @@
 namespace Amber
 {
 
-static const uint32_t s_BufferSize = 10 * 1024 * 1024; // 10 MB
-
-RenderCommandQueue::RenderCommandQueue()
+RenderCommandQueue::RenderCommandQueue(size_t capacity)
+    : m_Capacity(capacity)
 {
-    m_CommandBuffer = new byte[s_BufferSize];
+    m_CommandBuffer = new byte[m_Capacity];
     m_CommandBufferPtr = m_CommandBuffer;
-    memset(m_CommandBuffer, 0, s_BufferSize);
+    memset(m_CommandBuffer, 0, m_Capacity);
 }
 
 RenderCommandQueue::~RenderCommandQueue()
 {
     delete[] m_CommandBuffer;
+
+    for (auto& page : m_DataPages)
+        delete[] page.Data;
 }
 
 void* RenderCommandQueue::Allocate(RenderCommandFn func, size_t size)
 {
+    AB_CORE_ASSERT(m_CommandBufferPtr + sizeof(func) + sizeof(size_t) + size <= m_CommandBuffer + m_Capacity, "Render command queue is full!");
+
     *(RenderCommandFn*)m_CommandBufferPtr = func;
     m_CommandBufferPtr += sizeof(func);
 
@@ -51,6 +55,38 @@ void RenderCommandQueue::Execute()
 
     m_CommandBufferPtr = m_CommandBuffer;
     m_CommandCount = 0;
+
+    m_DataPageIndex = 0;
+    m_DataOffset = 0;
+}
+
+void* RenderCommandQueue::AllocateData(size_t size)
+{
+    size = (size + 15) & ~(size_t)15;
+
+    while (m_DataPageIndex < m_DataPages.size() && m_DataOffset + size > m_DataPages[m_DataPageIndex].Size)
+    {
+        m_DataPageIndex++;
+        m_DataOffset = 0;
+    }
+
+    if (m_DataPageIndex == m_DataPages.size())
+    {
+        size_t pageSize = size > DataPageSize ? size : DataPageSize;
+        m_DataPages.push_back({ new byte[pageSize], pageSize });
+    }
+
+    void* memory = m_DataPages[m_DataPageIndex].Data + m_DataOffset;
+    m_DataOffset += size;
+
+    return memory;
+}
+
+void* RenderCommandQueue::CopyData(const void* data, size_t size)
+{
+    void* memory = AllocateData(size);
+    memcpy(memory, data, size);
+    return memory;
 }
 
 }
\ No newline at end of file
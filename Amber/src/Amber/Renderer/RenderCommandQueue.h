@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "Amber/Core/Base.h"
 
 namespace Amber
@@ -10,16 +12,39 @@ class RenderCommandQueue
 public:
     typedef void(*RenderCommandFn)(void*);
 
-    RenderCommandQueue();
+    RenderCommandQueue(size_t capacity = 10 * 1024 * 1024);
     ~RenderCommandQueue();
 
+    RenderCommandQueue(const RenderCommandQueue&) = delete;
+    RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
     void* Allocate(RenderCommandFn func, size_t size);
     void Execute();
 
+    // Linear memory for data the commands read, all of it is released at once after the queue has executed
+    void* AllocateData(size_t size);
+    void* CopyData(const void* data, size_t size);
+
+    uint32_t GetCommandCount() const { return m_CommandCount; }
+
 private:
+    size_t m_Capacity;
     byte* m_CommandBuffer;
     byte* m_CommandBufferPtr;
     uint32_t m_CommandCount = 0;
+
+    struct DataPage
+    {
+        byte* Data;
+        size_t Size;
+    };
+
+    static constexpr size_t DataPageSize = 4 * 1024 * 1024;
+
+    // Pages are kept across frames, so steady state recording does not touch the heap
+    std::vector<DataPage> m_DataPages;
+    uint32_t m_DataPageIndex = 0;
+    size_t m_DataOffset = 0;
 };
 
 }
@@ -0,0 +1,208 @@
+#include "abpch.h"
+#include "RenderGraph.h"
+
+#include "Amber/Renderer/RenderCommand.h"
+#include "Amber/Renderer/Renderer.h"
+
+namespace Amber
+{
+
+void RenderGraph::PassBuilder::Read(const std::string& resource)
+{
+    uint32_t index = m_Graph.GetResourceIndex(resource);
+    AB_CORE_ASSERT(m_Graph.m_Resources[index].Imported || m_Graph.m_Resources[index].Written, "Render graph resource is read before it is written!");
+
+    m_Graph.m_Passes[m_PassIndex].Reads.push_back(index);
+}
+
+void RenderGraph::PassBuilder::Write(const std::string& resource)
+{
+    uint32_t index = m_Graph.GetResourceIndex(resource);
+    m_Graph.m_Resources[index].Written = true;
+
+    m_Graph.m_Passes[m_PassIndex].Writes.push_back(index);
+}
+
+void RenderGraph::PassBuilder::WriteImage(const std::string& resource)
+{
+    Write(resource);
+    m_Graph.m_Passes[m_PassIndex].ImageWrites.push_back(m_Graph.GetResourceIndex(resource));
+}
+
+void RenderGraph::PassBuilder::SetSideEffect()
+{
+    m_Graph.m_Passes[m_PassIndex].SideEffect = true;
+}
+
+void RenderGraph::ImportFramebuffer(const std::string& name, const Ref<Framebuffer>& framebuffer)
+{
+    auto& resource = m_Resources[AddResource(name)];
+    resource.Framebuffer = framebuffer;
+    resource.Specification = framebuffer->GetSpecification();
+    resource.Imported = true;
+}
+
+void RenderGraph::CreateFramebuffer(const std::string& name, const FramebufferSpecification& spec)
+{
+    m_Resources[AddResource(name)].Specification = spec;
+}
+
+void RenderGraph::MarkOutput(const std::string& resource)
+{
+    m_Resources[GetResourceIndex(resource)].Output = true;
+}
+
+void RenderGraph::AddPass(const std::string& name, const SetupFunction& setup, const ExecuteFunction& execute)
+{
+    AB_CORE_ASSERT(!m_Compiled, "Render graph has already been compiled!");
+
+    auto& pass = m_Passes.emplace_back();
+    pass.Name = name;
+    pass.Execute = execute;
+
+    PassBuilder builder(*this, (uint32_t)m_Passes.size() - 1);
+    setup(builder);
+}
+
+void RenderGraph::Compile()
+{
+    // Walk backwards from the outputs, a pass survives only if something later needs what it writes
+    std::vector<bool> needed(m_Resources.size());
+    for (uint32_t i = 0; i < m_Resources.size(); i++)
+        needed[i] = m_Resources[i].Output;
+
+    for (int i = (int)m_Passes.size() - 1; i >= 0; i--)
+    {
+        auto& pass = m_Passes[i];
+        pass.Culled = !pass.SideEffect;
+        for (uint32_t write : pass.Writes)
+        {
+            if (needed[write])
+                pass.Culled = false;
+        }
+
+        if (pass.Culled)
+            continue;
+
+        for (uint32_t read : pass.Reads)
+            needed[read] = true;
+    }
+
+    for (auto& resource : m_Resources)
+    {
+        resource.FirstUse = UINT32_MAX;
+        resource.LastUse = 0;
+    }
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        auto& pass = m_Passes[i];
+        if (pass.Culled)
+            continue;
+
+        auto markUse = [&](uint32_t index) {
+            auto& resource = m_Resources[index];
+            resource.FirstUse = glm::min(resource.FirstUse, i);
+            resource.LastUse = glm::max(resource.LastUse, i);
+        };
+
+        for (uint32_t read : pass.Reads)
+            markUse(read);
+        for (uint32_t write : pass.Writes)
+            markUse(write);
+    }
+
+    m_Compiled = true;
+}
+
+void RenderGraph::Execute()
+{
+    AB_CORE_ASSERT(m_Compiled, "Render graph must be compiled before it is executed!");
+
+    auto pool = FramebufferPool::GetGlobal();
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        auto& pass = m_Passes[i];
+        if (pass.Culled)
+            continue;
+
+        // Transients that are used by disjoint ranges of passes can end up sharing a pooled target
+        for (auto& resource : m_Resources)
+        {
+            if (!resource.Imported && resource.FirstUse == i)
+                resource.Framebuffer = pool->AllocateBuffer(resource.Specification);
+        }
+
+        bool barrier = false;
+        for (uint32_t read : pass.Reads)
+        {
+            auto& resource = m_Resources[read];
+            barrier |= resource.PendingImageWrite;
+            resource.PendingImageWrite = false;
+        }
+
+        if (barrier)
+            RenderCommand::Barrier((uint32_t)BarrierType::ShaderImageAccess | (uint32_t)BarrierType::TextureFetch | (uint32_t)BarrierType::Framebuffer);
+
+        Renderer::GetGPUProfiler()->BeginScope(pass.Name);
+        pass.Execute(*this);
+        Renderer::GetGPUProfiler()->EndScope();
+
+        for (uint32_t write : pass.ImageWrites)
+            m_Resources[write].PendingImageWrite = true;
+
+        for (auto& resource : m_Resources)
+        {
+            if (!resource.Imported && resource.LastUse == i && resource.Framebuffer)
+            {
+                pool->ReleaseBuffer(resource.Framebuffer);
+                resource.Framebuffer = nullptr;
+            }
+        }
+    }
+}
+
+void RenderGraph::Reset()
+{
+    m_Resources.clear();
+    m_ResourceIndices.clear();
+    m_Passes.clear();
+    m_Compiled = false;
+}
+
+const Ref<Framebuffer>& RenderGraph::GetFramebuffer(const std::string& name) const
+{
+    const auto& resource = m_Resources[GetResourceIndex(name)];
+    AB_CORE_ASSERT(resource.Framebuffer, "Render graph resource is not allocated!");
+    return resource.Framebuffer;
+}
+
+uint32_t RenderGraph::GetCulledPassCount() const
+{
+    uint32_t count = 0;
+    for (const auto& pass : m_Passes)
+    {
+        if (pass.Culled)
+            count++;
+    }
+    return count;
+}
+
+uint32_t RenderGraph::AddResource(const std::string& name)
+{
+    AB_CORE_ASSERT(!HasResource(name), "Render graph resource already exists!");
+
+    uint32_t index = (uint32_t)m_Resources.size();
+    m_Resources.emplace_back().Name = name;
+    m_ResourceIndices[name] = index;
+    return index;
+}
+
+uint32_t RenderGraph::GetResourceIndex(const std::string& name) const
+{
+    auto it = m_ResourceIndices.find(name);
+    AB_CORE_ASSERT(it != m_ResourceIndices.end(), "Unknown render graph resource!");
+    return it->second;
+}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Amber/Core/Base.h"
+
+#include "Amber/Renderer/Framebuffer.h"
+
+namespace Amber
+{
+
+// Rebuilt every frame. Passes declare the named framebuffers they read and write, compiling
+// culls passes whose results nothing consumes and works out how long each transient target lives.
+class RenderGraph
+{
+public:
+    class PassBuilder
+    {
+    public:
+        void Read(const std::string& resource);
+        void Write(const std::string& resource);
+        // Writes through image stores, readers in later passes get a memory barrier first
+        void WriteImage(const std::string& resource);
+
+        // Keeps the pass even when nothing reads what it writes
+        void SetSideEffect();
+
+    private:
+        PassBuilder(RenderGraph& graph, uint32_t passIndex)
+            : m_Graph(graph), m_PassIndex(passIndex) {}
+
+        RenderGraph& m_Graph;
+        uint32_t m_PassIndex;
+
+        friend class RenderGraph;
+    };
+
+    using SetupFunction = std::function<void(PassBuilder&)>;
+    using ExecuteFunction = std::function<void(RenderGraph&)>;
+
+    void ImportFramebuffer(const std::string& name, const Ref<Framebuffer>& framebuffer);
+    // Allocated from the framebuffer pool just before its first use and released after its last one
+    void CreateFramebuffer(const std::string& name, const FramebufferSpecification& spec);
+    void MarkOutput(const std::string& resource);
+
+    void AddPass(const std::string& name, const SetupFunction& setup, const ExecuteFunction& execute);
+
+    void Compile();
+    void Execute();
+    void Reset();
+
+    bool HasResource(const std::string& name) const { return m_ResourceIndices.find(name) != m_ResourceIndices.end(); }
+    // Transient framebuffers only exist while a pass that uses them is executing
+    const Ref<Framebuffer>& GetFramebuffer(const std::string& name) const;
+
+    uint32_t GetPassCount() const { return (uint32_t)m_Passes.size(); }
+    uint32_t GetCulledPassCount() const;
+
+private:
+    struct Pass
+    {
+        std::string Name;
+        ExecuteFunction Execute;
+        std::vector<uint32_t> Reads;
+        std::vector<uint32_t> Writes;
+        std::vector<uint32_t> ImageWrites;
+        bool SideEffect = false;
+        bool Culled = false;
+    };
+
+    struct Resource
+    {
+        std::string Name;
+        FramebufferSpecification Specification;
+        Ref<Framebuffer> Framebuffer;
+        bool Imported = false;
+        bool Output = false;
+        bool Written = false;
+        bool PendingImageWrite = false;
+        uint32_t FirstUse = 0, LastUse = 0;
+    };
+
+    uint32_t AddResource(const std::string& name);
+    uint32_t GetResourceIndex(const std::string& name) const;
+
+    std::vector<Resource> m_Resources;
+    std::unordered_map<std::string, uint32_t> m_ResourceIndices;
+    std::vector<Pass> m_Passes;
+    bool m_Compiled = false;
+};
+
+}
@@ -13,6 +13,7 @@ Ref<RenderPass> RenderPass::Create(const RenderPassSpecification& spec)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLRenderPass>::Create(spec);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Render passes are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
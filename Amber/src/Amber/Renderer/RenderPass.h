@@ -10,6 +10,9 @@ namespace Amber
 struct RenderPassSpecification
 {
     Ref<Framebuffer> TargetFramebuffer;
+
+    // Label for the pass's GPU timing
+    std::string DebugName = "RenderPass";
 };
 
 class RenderPass : public RefCounted
@@ -4,6 +4,7 @@
 #include <assimp/Importer.hpp>
 #include <glad/glad.h>
 
+#include "Amber/Renderer/MaterialProperties.h"
 #include "Amber/Renderer/Renderer2D.h"
 #include "Amber/Renderer/SceneRenderer.h"
 #include "Amber/Renderer/Shader.h"
@@ -15,6 +16,7 @@ struct RendererData
 {
     Scope<ShaderLibrary> ShaderLibrary;
     Ref<RenderPass> ActiveRenderPass;
+    Ref<GPUProfiler> GPUProfiler;
 };
 
 static RendererData s_Data;
@@ -23,15 +25,20 @@ void Renderer::Init()
 {
     AB_PROFILE_FUNCTION();
 
+    // Shader compiles look at the driver capabilities, so they are queried first
+    RenderCommand::Init();
+
     s_Data.ShaderLibrary = CreateScope<ShaderLibrary>();
 
-    s_Data.ShaderLibrary->Load(ShaderType::StandardStatic, "assets/shaders/AmberPBR.glsl");
-    s_Data.ShaderLibrary->Load(ShaderType::StandardAnimated, "assets/shaders/AmberPBR_Animated.glsl");
+    s_Data.ShaderLibrary->LoadBatch({
+        { ShaderType::StandardStatic, "assets/shaders/AmberPBR.glsl" },
+        { ShaderType::StandardAnimated, "assets/shaders/AmberPBR.glsl" },
 
-    s_Data.ShaderLibrary->Load(ShaderType::UnlitColor, "assets/shaders/Unlit_Color.glsl");
-    s_Data.ShaderLibrary->Load(ShaderType::UnlitTexture, "assets/shaders/Unlit_Texture.glsl");
+        { ShaderType::UnlitColor, "assets/shaders/Unlit_Color.glsl" },
+        { ShaderType::UnlitTexture, "assets/shaders/Unlit_Texture.glsl" }
+    });
 
-    RenderCommand::Init();
+    s_Data.GPUProfiler = GPUProfiler::Create();
     Renderer2D::Init();
     SceneRenderer::Init();
 }
@@ -43,6 +50,9 @@ void Renderer::Shutdown()
 
 void Renderer::WaitAndRender()
 {
+    FramebufferPool::GetGlobal()->EndFrame();
+    s_Data.GPUProfiler->EndFrame();
+
     RenderCommand::Submit([] {
         GLenum error = glGetError();
         while (error != GL_NO_ERROR)
@@ -59,6 +69,7 @@ void Renderer::BeginRenderPass(const Ref<RenderPass>& renderpass, bool clear)
     AB_CORE_ASSERT(renderpass, "Render pass is null!");
 
     s_Data.ActiveRenderPass = renderpass;
+    s_Data.GPUProfiler->BeginScope(renderpass->GetSpecification().DebugName);
     renderpass->GetSpecification().TargetFramebuffer->Bind();
 
     if (clear)
@@ -74,6 +85,7 @@ void Renderer::EndRenderPass()
     AB_CORE_ASSERT(s_Data.ActiveRenderPass, "No active render pass!");
 
     s_Data.ActiveRenderPass->GetSpecification().TargetFramebuffer->Unbind();
+    s_Data.GPUProfiler->EndScope();
     s_Data.ActiveRenderPass = nullptr;
 }
 
@@ -82,7 +94,7 @@ void Renderer::DrawFullscreenQuad(const Ref<MaterialInstance>& material)
     Renderer2D::DrawFullscreenQuad(material);
 }
 
-void Renderer::DrawMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial)
+void Renderer::DrawMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial, uint32_t lod, int32_t objectIndex)
 {
     mesh->Bind();
 
@@ -90,26 +102,54 @@ void Renderer::DrawMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<Material
     {
         auto baseMaterial = mesh->GetMaterial();
         auto& boneTransforms = mesh->GetBoneTransforms();
-        baseMaterial->Set("u_BoneTransform", *boneTransforms.data());
+        baseMaterial->Set(MaterialProperties::BoneTransform, *boneTransforms.data());
         if (overrideMaterial)
-            overrideMaterial->Set("u_BoneTransform", *boneTransforms.data());
+            overrideMaterial->Set(MaterialProperties::BoneTransform, *boneTransforms.data());
     }
 
+    // Only needed when the entity is not in the GPU scene, and then the same for every submesh
+    glm::mat3 normalTransform(1.0f);
+    if (objectIndex < 0)
+        normalTransform = glm::transpose(glm::inverse(glm::mat3(transform)));
+
     auto materials = mesh->GetMaterials();
-    for (Submesh& submesh : mesh->GetSubmeshes())
+    auto& submeshes = mesh->GetSubmeshes();
+    for (uint32_t i = 0; i < (uint32_t)submeshes.size(); i++)
     {
+        Submesh& submesh = submeshes[i];
         auto material = overrideMaterial ? overrideMaterial : materials[submesh.MaterialIndex];
-        glm::mat4 transformMatrix = transform * submesh.Transform;
-        glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(transformMatrix)));
-        material->Set("u_Transform", transformMatrix);
+        if (!material->IsReady())
+            continue;
 
         auto shaderType = material->GetShader()->GetType();
         if (shaderType == ShaderType::StandardStatic || shaderType == ShaderType::StandardAnimated)
-            material->Set("u_NormalTransform", normalTransform);
+        {
+            // The submesh transform lives in the mesh's storage buffer and the entity's in the GPU scene,
+            // so a resident entity only changes the indices between draws
+            if (objectIndex < 0)
+            {
+                material->Set(MaterialProperties::Transform, transform);
+                material->Set(MaterialProperties::NormalTransform, normalTransform);
+            }
+            material->Set(MaterialProperties::ObjectIndex, objectIndex);
+            material->Set(MaterialProperties::SubmeshIndex, (int32_t)i);
+        }
+        else
+        {
+            material->Set(MaterialProperties::Transform, transform * submesh.Transform);
+        }
+
+        uint32_t baseIndex = submesh.BaseIndex, indexCount = submesh.IndexCount;
+        if (lod > 0 && !submesh.LODs.empty())
+        {
+            const auto& level = submesh.LODs[glm::min(lod, (uint32_t)submesh.LODs.size()) - 1];
+            baseIndex = level.BaseIndex;
+            indexCount = level.IndexCount;
+        }
 
         material->Bind();
         RenderCommand::DrawIndexedOffset(
-            submesh.IndexCount, PrimitiveType::Triangles, (void*)(sizeof(uint32_t) * submesh.BaseIndex), 
+            indexCount, PrimitiveType::Triangles, (void*)(sizeof(uint32_t) * baseIndex), 
             submesh.BaseVertex, 
             material->GetFlag(MaterialFlag::DepthTest), material->GetFlag(MaterialFlag::StencilTest));
     }
@@ -165,4 +205,9 @@ const Scope<ShaderLibrary>& Renderer::GetShaderLibrary()
     return s_Data.ShaderLibrary;
 }
 
+const Ref<GPUProfiler>& Renderer::GetGPUProfiler()
+{
+    return s_Data.GPUProfiler;
+}
+
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "Amber/Math/Frustum.h"
 
+#include "Amber/Renderer/GPUProfiler.h"
 #include "Amber/Renderer/Mesh.h"
 #include "Amber/Renderer/RenderCommand.h"
 #include "Amber/Renderer/RenderPass.h"
@@ -30,7 +31,8 @@ public:
     static void EndRenderPass();
 
     static void DrawFullscreenQuad(const Ref<MaterialInstance>& material);
-    static void DrawMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial = nullptr);
+    // objectIndex is a GPUScene slot holding transform, the standard shaders then only get the submesh's own transform
+    static void DrawMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial = nullptr, uint32_t lod = 0, int32_t objectIndex = -1);
 
     static void DrawAABB(const Math::AABB& aabb, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
     static void DrawAABB(Ref<Mesh> mesh, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
@@ -38,6 +40,7 @@ public:
     static void DrawFrustum(const Math::Frustum& frustum, const glm::vec4& color = glm::vec4(1.0f));
 
     static const Scope<ShaderLibrary>& GetShaderLibrary();
+    static const Ref<GPUProfiler>& GetGPUProfiler();
     static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 };
 
@@ -2,6 +2,7 @@
 #include "Renderer2D.h"
 
 #include "Amber/Renderer/Material.h"
+#include "Amber/Renderer/MaterialProperties.h"
 #include "Amber/Renderer/RenderCommand.h"
 #include "Amber/Renderer/Renderer.h"
 #include "Amber/Renderer/Shader.h"
@@ -84,8 +85,10 @@ void Renderer2D::Init()
 
     s_Data.ShaderLibrary = CreateScope<ShaderLibrary>();
 
-    s_Data.ShaderLibrary->Load("assets/shaders/Renderer2D.glsl");
-    s_Data.ShaderLibrary->Load("assets/shaders/Line.glsl");
+    s_Data.ShaderLibrary->LoadBatch({
+        "assets/shaders/Renderer2D.glsl",
+        "assets/shaders/Line.glsl"
+    });
 
     // Quads
     s_Data.QuadVertexBuffer = VertexBuffer::Create(s_Data.MaxQuadVertices * sizeof(QuadVertex));
@@ -223,21 +226,25 @@ void Renderer2D::FlushQuads()
     if (s_Data.QuadIndexCount == 0)
         return;
 
-    s_Data.QuadMaterial->Bind();
-    s_Data.QuadVertexBuffer->Bind();
-    s_Data.QuadPipeline->Bind();
-    s_Data.QuadIndexBuffer->Bind();
+    // The batch is dropped while its shader is still compiling
+    if (s_Data.QuadMaterial->IsReady())
+    {
+        s_Data.QuadMaterial->Bind();
+        s_Data.QuadVertexBuffer->Bind();
+        s_Data.QuadPipeline->Bind();
+        s_Data.QuadIndexBuffer->Bind();
 
-    uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
-    s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
+        uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
+        s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
 
-    for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-        s_Data.TextureSlots[i]->Bind(i);
+        for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
+            s_Data.TextureSlots[i]->Bind(i);
 
-    RenderCommand::DrawIndexed(s_Data.QuadIndexCount, PrimitiveType::Triangles, 
-                               s_Data.QuadMaterial->GetFlag(MaterialFlag::DepthTest),
-                               s_Data.QuadMaterial->GetFlag(MaterialFlag::StencilTest));
-    s_Data.Stats.DrawCalls++;
+        RenderCommand::DrawIndexed(s_Data.QuadIndexCount, PrimitiveType::Triangles, 
+                                   s_Data.QuadMaterial->GetFlag(MaterialFlag::DepthTest),
+                                   s_Data.QuadMaterial->GetFlag(MaterialFlag::StencilTest));
+        s_Data.Stats.DrawCalls++;
+    }
 
     s_Data.QuadIndexCount = 0;
     s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
@@ -251,16 +258,19 @@ void Renderer2D::FlushLines()
     if (s_Data.LineIndexCount == 0)
         return;
 
-    s_Data.LineMaterial->Bind();
-    s_Data.LineVertexBuffer->Bind();
-    s_Data.LinePipeline->Bind();
-    s_Data.LineIndexBuffer->Bind();
+    if (s_Data.LineMaterial->IsReady())
+    {
+        s_Data.LineMaterial->Bind();
+        s_Data.LineVertexBuffer->Bind();
+        s_Data.LinePipeline->Bind();
+        s_Data.LineIndexBuffer->Bind();
 
-    uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase);
-    s_Data.LineVertexBuffer->SetData(s_Data.LineVertexBufferBase, dataSize);
+        uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase);
+        s_Data.LineVertexBuffer->SetData(s_Data.LineVertexBufferBase, dataSize);
 
-    RenderCommand::DrawIndexed(s_Data.LineIndexCount, PrimitiveType::Lines, false);
-    s_Data.Stats.DrawCalls++;
+        RenderCommand::DrawIndexed(s_Data.LineIndexCount, PrimitiveType::Lines, false);
+        s_Data.Stats.DrawCalls++;
+    }
 
     s_Data.LineIndexCount = 0;
     s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
@@ -357,13 +367,16 @@ void Renderer2D::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::v
 
 void Renderer2D::DrawQuad(Ref<MaterialInstance> material, const glm::mat4& transform)
 {
+    if (material && !material->IsReady())
+        return;
+
     bool depthTest = false;
     if (material)
     {
         material->Bind();
         depthTest = material->GetFlag(MaterialFlag::DepthTest);
 
-        material->Set("u_Transform", transform);
+        material->Set(MaterialProperties::Transform, transform);
     }
 
     s_Data.FullscreenQuadVertexBuffer->Bind();
@@ -374,6 +387,9 @@ void Renderer2D::DrawQuad(Ref<MaterialInstance> material, const glm::mat4& trans
 
 void Renderer2D::DrawFullscreenQuad(Ref<MaterialInstance> material)
 {
+    if (material && !material->IsReady())
+        return;
+
     bool depthTest = false;
     bool stencilTest = false;
     if (material)
@@ -4,6 +4,7 @@
 #include "Amber/Renderer/Renderer.h"
 
 #include "Amber/Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Amber/Platform/Vulkan/VulkanRendererAPI.h"
 
 namespace Amber 
 {
@@ -15,6 +16,7 @@ Scope<RendererAPI> RendererAPI::Create()
     switch (s_API) 
     {
         case RendererAPI::API::OpenGL:  return CreateScope<OpenGLRendererAPI>();
+        case RendererAPI::API::Vulkan:  return CreateScope<VulkanRendererAPI>();
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
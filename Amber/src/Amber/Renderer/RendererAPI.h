@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include <glm/glm.hpp>
 
@@ -17,6 +18,10 @@ struct RenderAPICapabilities
     int MaxColorAttachments;
     int MaxTextureSamples;
     int MaxTextureSlots;
+
+    std::unordered_set<std::string> Extensions;
+
+    bool HasExtension(const std::string& name) const { return Extensions.find(name) != Extensions.end(); }
 };
 
 enum class ComparisonFunc
@@ -39,12 +44,23 @@ enum class StencilOperation
     Keep, Zero, Replace, Incr, IncrWrap, Decr, DecrWrap, Invert
 };
 
+// Makes earlier incoherent shader writes visible to the listed kinds of access
+enum class BarrierType
+{
+    ShaderImageAccess = BIT(0),
+    TextureFetch      = BIT(1),
+    ShaderStorage     = BIT(2),
+    Command           = BIT(3),
+    Framebuffer       = BIT(4),
+    TextureUpdate     = BIT(5)
+};
+
 class RendererAPI 
 {
 public:
     enum class API 
     {
-        None = 0, OpenGL
+        None = 0, OpenGL, Vulkan
     };
 
     virtual void Init() = 0;
@@ -57,10 +73,18 @@ public:
     virtual void SetLineThickness(float thickness) = 0;
     virtual void SetPointSize(float size) = 0;
     virtual void SetRasterizationMode(RasterizationMode mode) = 0;
+    virtual void SetDepthFunction(ComparisonFunc func) = 0;
     virtual void SetStencilFunction(ComparisonFunc func, uint8_t ref, uint8_t mask) = 0;
     virtual void SetStencilMask(uint8_t mask) = 0;
     virtual void SetStencilOperation(StencilOperation stencilFail, StencilOperation depthFail, StencilOperation depthPass) = 0;
 
+    // Takes a mask of BarrierType values
+    virtual void Barrier(uint32_t barriers) = 0;
+
+    virtual void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
+    // Reads the three group counts as uint32s from the buffer at the byte offset
+    virtual void DispatchIndirect(RendererID argumentBuffer, uint32_t offset) = 0;
+
     virtual void DrawIndexed(uint32_t indexCount, PrimitiveType type, bool depthTest = true, bool stencilTest = false) = 0;
     virtual void DrawIndexedOffset(uint32_t indexCount, PrimitiveType type, void* indexBufferPointer, uint32_t offset, bool depthTest = true, bool stencilTest = false) = 0;
 
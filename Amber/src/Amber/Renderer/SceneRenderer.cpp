@@ -2,10 +2,21 @@
 #include "SceneRenderer.h"
 
 #include <glad/glad.h>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <stb_image.h>
+
+#include "Amber/Core/Time.h"
 
 #include "Amber/Renderer/Camera.h"
+#include "Amber/Renderer/ComputePipeline.h"
+#include "Amber/Renderer/EnvironmentCache.h"
 #include "Amber/Renderer/Framebuffer.h"
+#include "Amber/Renderer/GPUScene.h"
+#include "Amber/Renderer/GPUProfiler.h"
+#include "Amber/Renderer/MaterialProperties.h"
 #include "Amber/Renderer/RenderCommand.h"
+#include "Amber/Renderer/RenderGraph.h"
 #include "Amber/Renderer/Renderer.h"
 #include "Amber/Renderer/Renderer2D.h"
 #include "Amber/Renderer/Shader.h"
@@ -18,6 +29,8 @@ struct SceneRendererData
     Scope<ShaderLibrary> ShaderLibrary;
 
     Scene* ActiveScene = nullptr;
+    Ref<GPUScene> GPUScene;
+    uint32_t GPUSceneObjects = 0, GPUSceneUploadedObjects = 0, GPUSceneUploadRanges = 0;
     struct SceneInfo
     {
         SceneRendererCamera SceneCamera;
@@ -31,16 +44,52 @@ struct SceneRendererData
     Ref<RenderPass> GeometryPass;
     Ref<RenderPass> CompositePass;
 
+    uint32_t ViewportWidth = 1280, ViewportHeight = 720;
+    uint32_t RenderWidth = 1280, RenderHeight = 720;
+    float ResolutionScale = 1.0f;
+
+    Ref<RenderPass> TAAPasses[2];
+    uint32_t TAAHistoryIndex = 0;
+    uint32_t TAAFrameIndex = 0;
+    bool TAAHistoryValid = false;
+    glm::mat4 ViewProjection = glm::mat4(1.0f), PreviousViewProjection = glm::mat4(1.0f);
+    glm::vec2 PreviousViewportScale = glm::vec2(1.0f);
+
+    // Scene color consumed by the composite pass, after anti-aliasing has been resolved
+    Ref<Texture2D> SceneColor;
+
+    // Outputs of the selection outline pass, their targets belong to the render graph
+    Ref<Texture2D> SelectionMask;
+    Ref<Texture2D> SelectionDistanceField;
+    // Kept across frames, only their targets are taken from the graph's pool
+    Ref<RenderPass> SelectionMaskPass;
+    Ref<RenderPass> JumpFloodPasses[2];
+
+    RenderGraph Graph;
+
+    Ref<RenderPass> CameraPreviewGeometryPass;
+    Ref<RenderPass> CameraPreviewCompositePass;
+    Ref<MaterialInstance> CameraPreviewCompositeMaterial;
+    SceneRendererCamera CameraPreviewCamera;
+    bool CameraPreviewRequested = false;
+    bool CameraPreviewValid = false;
+    double CameraPreviewRefreshTime = 0.0;
+
     Ref<Texture2D> BRDFLUT;
 
+    std::vector<Ref<EnvironmentMapJob>> EnvironmentJobs;
+
     struct MeshDrawCommand
     {
         Ref<Mesh> Mesh;
         Ref<MaterialInstance> Material;
         glm::mat4 Transform;
+        uint32_t LOD;
+        int32_t ObjectIndex;
     };
     std::vector<MeshDrawCommand> MeshDrawList;
     std::vector<MeshDrawCommand> SelectedDrawList;
+    Ref<StaticMeshBatch> StaticBatch;
 
     struct CameraDrawCommand
     {
@@ -52,63 +101,262 @@ struct SceneRendererData
     std::vector<Renderer2D::QuadData> SpriteDrawList;
 
     Ref<Material> CompositeBaseMaterial;
+    Ref<MaterialInstance> CompositeMaterial;
     Ref<MaterialInstance> GridMaterial;
+    Ref<MaterialInstance> TAAMaterial;
     Ref<MaterialInstance> OutlineMaterial;
     Ref<MaterialInstance> OutlineAnimatedMaterial;
+    Ref<MaterialInstance> JumpFloodInitMaterial;
+    Ref<MaterialInstance> JumpFloodMaterial;
+    Ref<MaterialInstance> JumpFloodOutlineMaterial;
 
     SceneRendererOptions Options;
 };
 
 static SceneRendererData s_Data;
 
+static float Halton(uint32_t index, uint32_t base)
+{
+    float result = 0.0f;
+    float fraction = 1.0f;
+    while (index > 0)
+    {
+        fraction /= (float)base;
+        result += fraction * (float)(index % base);
+        index /= base;
+    }
+
+    return result;
+}
+
+static FramebufferSpecification GetColorTargetSpecification(uint32_t width, uint32_t height, FramebufferFormat format = FramebufferFormat::RGBA16F)
+{
+    FramebufferSpecification spec;
+    spec.Width = width;
+    spec.Height = height;
+    spec.Format = format;
+    spec.DepthAttachmentType = DepthBufferType::None;
+    spec.StencilBuffer = false;
+    spec.ClearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    return spec;
+}
+
+// The composite shader applies gamma itself, so sRGB targets are only usable when sampling can skip the decode
+static FramebufferFormat GetCompositeFormat()
+{
+    if (s_Data.Options.CompositeFormat == FramebufferFormat::RGBA8_SRGB && !RendererAPI::GetCapabilities().HasExtension("GL_EXT_texture_sRGB_decode"))
+        return FramebufferFormat::RGBA8;
+
+    return s_Data.Options.CompositeFormat;
+}
+
+// Drawn after opaque geometry at the far plane, so only uncovered pixels pay for the cubemap lookup
+static void DrawSkybox(const glm::mat4& viewProj)
+{
+    s_Data.SceneData.SkyboxMaterial->Set("u_InverseVP", glm::inverse(viewProj));
+    s_Data.SceneData.SkyboxMaterial->Set("u_Rotation", s_Data.SceneData.SceneEnvironment.Rotation);
+
+    RenderCommand::SetDepthFunction(ComparisonFunc::LessEqual);
+    Renderer::DrawFullscreenQuad(s_Data.SceneData.SkyboxMaterial);
+    RenderCommand::SetDepthFunction(ComparisonFunc::Less);
+}
+
+// Conservative, only rejects boxes whose corners are all outside the same clip plane
+static bool IsVisible(const Math::AABB& aabb, const glm::mat4& viewProj)
+{
+    glm::vec4 corners[8];
+    for (uint32_t i = 0; i < 8; i++)
+        corners[i] = viewProj * glm::vec4(i & 1 ? aabb.Max.x : aabb.Min.x, i & 2 ? aabb.Max.y : aabb.Min.y, i & 4 ? aabb.Max.z : aabb.Min.z, 1.0f);
+
+    for (uint32_t axis = 0; axis < 3; axis++)
+    {
+        bool outsideMin = true, outsideMax = true;
+        for (auto& corner : corners)
+        {
+            outsideMin &= corner[axis] < -corner.w;
+            outsideMax &= corner[axis] > corner.w;
+        }
+
+        if (outsideMin || outsideMax)
+            return false;
+    }
+
+    return true;
+}
+
+// Scene uniforms, set on every base material each frame
+static constexpr MaterialProperty s_ViewProjectionProperty = "u_ViewProjection";
+static constexpr MaterialProperty s_ViewPositionProperty = "u_ViewPosition";
+static constexpr MaterialProperty s_IrradianceTextureProperty = "u_IrradianceTexture";
+static constexpr MaterialProperty s_IrradianceSHProperty = "u_IrradianceSH";
+static constexpr MaterialProperty s_UseIrradianceSHProperty = "u_UseIrradianceSH";
+static constexpr MaterialProperty s_RadianceTextureProperty = "u_RadianceTexture";
+static constexpr MaterialProperty s_BRDFLUTProperty = "u_BRDFLUT";
+static constexpr MaterialProperty s_EnvironmentRotationProperty = "u_EnvironmentRotation";
+static constexpr MaterialProperty s_LightDirectionProperty = "u_LightDirection";
+static constexpr MaterialProperty s_LightProperty = "u_Light";
+
+static void SetSceneUniforms(Ref<Material> baseMaterial, const glm::mat4& viewProj, const glm::vec3& cameraPosition);
+
+static void DrawStaticBatch(const glm::mat4& viewProj, const glm::vec3& cameraPosition)
+{
+    auto& batch = s_Data.StaticBatch;
+    if (!batch || batch->IsEmpty())
+        return;
+
+    batch->Bind();
+    for (auto& chunk : batch->GetChunks())
+    {
+        if (!IsVisible(chunk.BoundingBox, viewProj))
+            continue;
+
+        // Vertices are already in world space
+        for (auto& draw : chunk.Draws)
+        {
+            if (!draw.Material->IsReady())
+                continue;
+
+            SetSceneUniforms(draw.BaseMaterial, viewProj, cameraPosition);
+            draw.Material->Set(MaterialProperties::Transform, glm::mat4(1.0f));
+
+            auto shaderType = draw.Material->GetShader()->GetType();
+            if (shaderType == ShaderType::StandardStatic || shaderType == ShaderType::StandardAnimated)
+            {
+                draw.Material->Set(MaterialProperties::NormalTransform, glm::mat3(1.0f));
+                draw.Material->Set(MaterialProperties::ObjectIndex, -1);
+                draw.Material->Set(MaterialProperties::SubmeshIndex, -1);
+            }
+            draw.Material->Bind();
+            RenderCommand::DrawIndexedOffset(draw.IndexCount, PrimitiveType::Triangles, (void*)(sizeof(uint32_t) * draw.BaseIndex), 0,
+                draw.Material->GetFlag(MaterialFlag::DepthTest), draw.Material->GetFlag(MaterialFlag::StencilTest));
+        }
+    }
+}
+
+static void SetSceneUniforms(Ref<Material> baseMaterial, const glm::mat4& viewProj, const glm::vec3& cameraPosition)
+{
+    auto shaderType = baseMaterial->GetShader()->GetType();
+
+    baseMaterial->Set(s_ViewProjectionProperty, viewProj);
+    if (shaderType == ShaderType::StandardStatic || shaderType == ShaderType::StandardAnimated)
+    {
+        baseMaterial->Set(s_ViewPositionProperty, cameraPosition);
+
+        baseMaterial->Set(s_IrradianceTextureProperty, s_Data.SceneData.SceneEnvironment.IrradianceMap);
+        baseMaterial->Set(s_IrradianceSHProperty, s_Data.SceneData.SceneEnvironment.IrradianceSH);
+        baseMaterial->Set(s_UseIrradianceSHProperty, s_Data.SceneData.SceneEnvironment.IrradianceMap ? 0 : 1);
+        baseMaterial->Set(s_RadianceTextureProperty, s_Data.SceneData.SceneEnvironment.RadianceMap);
+        baseMaterial->Set(s_BRDFLUTProperty, s_Data.BRDFLUT);
+        baseMaterial->Set(s_EnvironmentRotationProperty, s_Data.SceneData.SceneEnvironment.Rotation);
+
+        struct LightUniform
+        {
+            glm::vec3 Radiance;
+            float Multiplier;
+        };
+        LightUniform light{ s_Data.SceneData.ActiveLight.Radiance, s_Data.SceneData.ActiveLight.Multiplier };
+
+        baseMaterial->Set(s_LightDirectionProperty, s_Data.SceneData.ActiveLight.Direction);
+        baseMaterial->Set(s_LightProperty, light);
+    }
+}
+
 void SceneRenderer::Init()
 {
     s_Data.ShaderLibrary = CreateScope<ShaderLibrary>();
 
-    s_Data.ShaderLibrary->Load("assets/shaders/EnvironmentIrradiance.glsl");
-    s_Data.ShaderLibrary->Load("assets/shaders/EnvironmentMipFilter.glsl");
-    s_Data.ShaderLibrary->Load("assets/shaders/EquirectangularToCubemap.glsl");
-    s_Data.ShaderLibrary->Load("assets/shaders/Grid.glsl");
-    s_Data.ShaderLibrary->Load("assets/shaders/Outline.glsl");
-    s_Data.ShaderLibrary->Load("assets/shaders/Outline_Animated.glsl");
-    s_Data.ShaderLibrary->Load("assets/shaders/SceneComposite.glsl");
+    s_Data.ShaderLibrary->LoadBatch({
+        "assets/shaders/EnvironmentIrradiance.glsl",
+        "assets/shaders/EnvironmentMipFilter.glsl",
+        "assets/shaders/EquirectangularToCubemap.glsl",
+        "assets/shaders/Grid.glsl",
+        "assets/shaders/JumpFlood.glsl",
+        "assets/shaders/JumpFloodInit.glsl",
+        "assets/shaders/JumpFloodOutline.glsl",
+        "assets/shaders/Outline.glsl",
+        "assets/shaders/Outline_Animated.glsl",
+        "assets/shaders/SceneComposite.glsl",
+        "assets/shaders/TemporalAA.glsl"
+    });
 
     FramebufferSpecification geoFramebufferSpec;
     geoFramebufferSpec.Width = 1280;
     geoFramebufferSpec.Height = 720;
-    geoFramebufferSpec.Format = FramebufferFormat::RGBA16F;
+    geoFramebufferSpec.Format = s_Data.Options.SceneColorFormat;
     geoFramebufferSpec.ClearColor = { 0.1f, 0.1f, 0.1f, 1.0f };
-    geoFramebufferSpec.Samples = 8;
+    geoFramebufferSpec.DepthAttachmentType = DepthBufferType::Texture;
+    geoFramebufferSpec.StencilBuffer = false;
+    geoFramebufferSpec.Samples = s_Data.Options.AntiAliasing == AntiAliasingMethod::MSAA ? s_Data.Options.MSAASamples : 1;
 
     RenderPassSpecification geoRenderPassSpec;
     geoRenderPassSpec.TargetFramebuffer = Framebuffer::Create(geoFramebufferSpec);
+    geoRenderPassSpec.DebugName = "SceneGeometry";
     s_Data.GeometryPass = RenderPass::Create(geoRenderPassSpec);
 
     FramebufferSpecification compFramebufferSpec;
     compFramebufferSpec.Width = 1280;
     compFramebufferSpec.Height = 720;
-    compFramebufferSpec.Format = FramebufferFormat::RGBA16F;
+    compFramebufferSpec.Format = GetCompositeFormat();
     compFramebufferSpec.ClearColor = { 0.5f, 0.1f, 0.1f, 1.0f };
 
     RenderPassSpecification compRenderPassSpec;
     compRenderPassSpec.TargetFramebuffer = Framebuffer::Create(compFramebufferSpec);
+    compRenderPassSpec.DebugName = "SceneComposite";
     s_Data.CompositePass = RenderPass::Create(compRenderPassSpec);
 
+    RenderPassSpecification maskRenderPassSpec;
+    maskRenderPassSpec.DebugName = "SelectionMask";
+    s_Data.SelectionMaskPass = RenderPass::Create(maskRenderPassSpec);
+
+    RenderPassSpecification jumpFloodRenderPassSpec;
+    jumpFloodRenderPassSpec.DebugName = "JumpFlood";
+    for (auto& jumpFloodPass : s_Data.JumpFloodPasses)
+        jumpFloodPass = RenderPass::Create(jumpFloodRenderPassSpec);
+
     s_Data.BRDFLUT = Texture2D::Create("assets/textures/BRDF_LUT.tga");
 
     s_Data.CompositeBaseMaterial = Ref<Material>::Create(s_Data.ShaderLibrary->Get("SceneComposite"));
+    s_Data.CompositeMaterial = Ref<MaterialInstance>::Create(s_Data.CompositeBaseMaterial);
     s_Data.GridMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(s_Data.ShaderLibrary->Get("Grid")));
+    s_Data.TAAMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(s_Data.ShaderLibrary->Get("TemporalAA")));
 
     s_Data.OutlineMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(s_Data.ShaderLibrary->Get("Outline")));
     s_Data.OutlineMaterial->SetFlag(MaterialFlag::DepthTest, false);
 
     s_Data.OutlineAnimatedMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(s_Data.ShaderLibrary->Get("Outline_Animated")));
     s_Data.OutlineAnimatedMaterial->SetFlag(MaterialFlag::DepthTest, false);
+
+    s_Data.JumpFloodInitMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(s_Data.ShaderLibrary->Get("JumpFloodInit")));
+    s_Data.JumpFloodInitMaterial->SetFlag(MaterialFlag::DepthTest, false);
+
+    s_Data.JumpFloodMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(s_Data.ShaderLibrary->Get("JumpFlood")));
+    s_Data.JumpFloodMaterial->SetFlag(MaterialFlag::DepthTest, false);
+
+    s_Data.JumpFloodOutlineMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(s_Data.ShaderLibrary->Get("JumpFloodOutline")));
+    s_Data.JumpFloodOutlineMaterial->SetFlag(MaterialFlag::DepthTest, false);
 }
 
 void SceneRenderer::SetViewportSize(uint32_t width, uint32_t height)
 {
-    s_Data.GeometryPass->GetSpecification().TargetFramebuffer->Resize(width, height);
+    s_Data.ViewportWidth = width;
+    s_Data.ViewportHeight = height;
+
+    // The geometry target only ever grows; scaled and smaller viewports render into a sub-rect of it
+    auto& geoFramebuffer = s_Data.GeometryPass->GetSpecification().TargetFramebuffer;
+    const auto& geoSpec = geoFramebuffer->GetSpecification();
+    if (width > geoSpec.Width || height > geoSpec.Height)
+    {
+        geoFramebuffer->Resize(glm::max(width, geoSpec.Width), glm::max(height, geoSpec.Height));
+
+        for (auto& taaPass : s_Data.TAAPasses)
+        {
+            if (taaPass)
+                taaPass->GetSpecification().TargetFramebuffer->Resize(geoSpec.Width, geoSpec.Height);
+        }
+        s_Data.TAAHistoryValid = false;
+    }
+
     s_Data.CompositePass->GetSpecification().TargetFramebuffer->Resize(width, height);
 }
 
@@ -123,6 +371,11 @@ void SceneRenderer::BeginScene(Scene* scene, const SceneRendererCamera& camera)
     s_Data.SceneData.SkyboxMaterial = scene->GetSkyboxMaterial();
     s_Data.SceneData.SceneEnvironment = scene->GetEnvironment();
     s_Data.SceneData.ActiveLight = scene->GetLight();
+
+    s_Data.GPUScene = scene->GetGPUScene();
+    s_Data.GPUSceneObjects = s_Data.GPUScene->GetObjectCount();
+    s_Data.GPUSceneUploadedObjects = s_Data.GPUScene->GetUploadedObjectCount();
+    s_Data.GPUSceneUploadRanges = s_Data.GPUScene->GetUploadRangeCount();
 }
 
 void SceneRenderer::EndScene()
@@ -139,14 +392,54 @@ void SceneRenderer::SubmitCamera(const SceneCamera& camera, const glm::mat4& tra
     s_Data.CameraDrawList.push_back({ camera, transform });
 }
 
-void SceneRenderer::SubmitMesh(const Ref<Mesh> mesh, const glm::mat4& transform, const Ref<MaterialInstance> overrideMaterial)
+static uint32_t SelectLOD(const Ref<Mesh>& mesh, const glm::mat4& transform, uint32_t currentLOD)
+{
+    uint32_t lodCount = mesh->GetLODCount();
+    if (lodCount == 1)
+        return 0;
+
+    const auto& aabb = mesh->GetBoundingBox();
+    glm::vec3 center = transform * glm::vec4((aabb.Min + aabb.Max) * 0.5f, 1.0f);
+    float scale = glm::max(glm::length(glm::vec3(transform[0])), glm::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+    float radius = glm::length(aabb.Max - aabb.Min) * 0.5f * scale;
+
+    // Diameter of the bounding sphere over the screen height; orthographic projections ignore distance
+    const auto& camera = s_Data.SceneData.SceneCamera;
+    const glm::mat4& projection = camera.Camera.GetProjectionMatrix();
+    float distance = projection[3][3] == 1.0f ? 1.0f : glm::max(-(camera.ViewMatrix * glm::vec4(center, 1.0f)).z, radius);
+    float screenSize = radius * projection[1][1] / distance * s_Data.Options.LODBias;
+
+    float hysteresis = s_Data.Options.LODHysteresis;
+    uint32_t lod = glm::min(currentLOD, lodCount - 1);
+    while (lod + 1 < lodCount && screenSize < mesh->GetLODScreenSize(lod + 1) * (1.0f - hysteresis))
+        lod++;
+    while (lod > 0 && screenSize > mesh->GetLODScreenSize(lod) * (1.0f + hysteresis))
+        lod--;
+
+    return lod;
+}
+
+void SceneRenderer::SubmitMesh(const Ref<Mesh> mesh, const glm::mat4& transform, const Ref<MaterialInstance> overrideMaterial, uint32_t* lodIndex, int32_t objectIndex)
+{
+    uint32_t lod = 0;
+    if (lodIndex)
+        lod = *lodIndex = SelectLOD(mesh, transform, *lodIndex);
+
+    s_Data.MeshDrawList.push_back({ mesh, overrideMaterial, transform, lod, objectIndex });
+}
+
+void SceneRenderer::SubmitSelectedMesh(const Ref<Mesh> mesh, const glm::mat4& transform, uint32_t* lodIndex, int32_t objectIndex)
 {
-    s_Data.MeshDrawList.push_back({ mesh, overrideMaterial, transform });
+    uint32_t lod = 0;
+    if (lodIndex)
+        lod = *lodIndex = SelectLOD(mesh, transform, *lodIndex);
+
+    s_Data.SelectedDrawList.push_back({ mesh, nullptr, transform, lod, objectIndex });
 }
 
-void SceneRenderer::SubmitSelectedMesh(const Ref<Mesh> mesh, const glm::mat4& transform)
+void SceneRenderer::SubmitStaticBatch(const Ref<StaticMeshBatch>& batch)
 {
-    s_Data.SelectedDrawList.push_back({ mesh, nullptr, transform });
+    s_Data.StaticBatch = batch;
 }
 
 void SceneRenderer::SubmitSprite(const Renderer2D::QuadData& quadData)
@@ -154,112 +447,191 @@ void SceneRenderer::SubmitSprite(const Renderer2D::QuadData& quadData)
     s_Data.SpriteDrawList.push_back(quadData);
 }
 
-void SceneRenderer::GeometryPass()
+void SceneRenderer::SubmitEnvironmentJob(const Ref<EnvironmentMapJob>& job)
 {
-    Renderer::BeginRenderPass(s_Data.GeometryPass);
-    RenderCommand::SetStencilMask(0);
+    s_Data.EnvironmentJobs.push_back(job);
+}
 
-    auto viewProj = s_Data.SceneData.SceneCamera.Camera.GetProjectionMatrix() * s_Data.SceneData.SceneCamera.ViewMatrix;
-    glm::vec3 cameraPosition = glm::inverse(s_Data.SceneData.SceneCamera.ViewMatrix)[3];
-    
-    // Skybox
-    s_Data.SceneData.SkyboxMaterial->Set("u_InverseVP", glm::inverse(viewProj));
-    s_Data.SceneData.SkyboxMaterial->Set("u_Rotation", s_Data.SceneData.SceneEnvironment.Rotation);
-    Renderer::DrawFullscreenQuad(s_Data.SceneData.SkyboxMaterial);
+void SceneRenderer::SubmitCameraPreview(const SceneRendererCamera& camera)
+{
+    s_Data.CameraPreviewCamera = camera;
+    s_Data.CameraPreviewRequested = true;
 
-    // Render entities
-    for (auto& drawCommand : s_Data.MeshDrawList)
+    uint32_t width = glm::max((uint32_t)(s_Data.ViewportWidth * s_Data.Options.CameraPreviewScale), 1u);
+    uint32_t height = glm::max((uint32_t)(s_Data.ViewportHeight * s_Data.Options.CameraPreviewScale), 1u);
+
+    if (!s_Data.CameraPreviewGeometryPass)
+    {
+        FramebufferSpecification geoFramebufferSpec;
+        geoFramebufferSpec.Width = width;
+        geoFramebufferSpec.Height = height;
+        geoFramebufferSpec.Format = s_Data.Options.SceneColorFormat;
+        geoFramebufferSpec.StencilBuffer = false;
+        geoFramebufferSpec.ClearColor = { 0.1f, 0.1f, 0.1f, 1.0f };
+
+        RenderPassSpecification geoRenderPassSpec;
+        geoRenderPassSpec.TargetFramebuffer = Framebuffer::Create(geoFramebufferSpec);
+        geoRenderPassSpec.DebugName = "CameraPreviewGeometry";
+        s_Data.CameraPreviewGeometryPass = RenderPass::Create(geoRenderPassSpec);
+
+        FramebufferSpecification compFramebufferSpec;
+        compFramebufferSpec.Width = width;
+        compFramebufferSpec.Height = height;
+        compFramebufferSpec.Format = GetCompositeFormat();
+        compFramebufferSpec.DepthAttachmentType = DepthBufferType::None;
+        compFramebufferSpec.StencilBuffer = false;
+        compFramebufferSpec.ClearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+        RenderPassSpecification compRenderPassSpec;
+        compRenderPassSpec.TargetFramebuffer = Framebuffer::Create(compFramebufferSpec);
+        compRenderPassSpec.DebugName = "CameraPreviewComposite";
+        s_Data.CameraPreviewCompositePass = RenderPass::Create(compRenderPassSpec);
+
+        s_Data.CameraPreviewCompositeMaterial = Ref<MaterialInstance>::Create(s_Data.CompositeBaseMaterial);
+        s_Data.CameraPreviewValid = false;
+    }
+    else
     {
-        auto baseMaterial = drawCommand.Mesh->GetMaterial();
-        auto shaderType = baseMaterial->GetShader()->GetType();
+        auto& geoSpec = s_Data.CameraPreviewGeometryPass->GetSpecification().TargetFramebuffer->GetSpecification();
+        if (geoSpec.Width != width || geoSpec.Height != height)
+        {
+            s_Data.CameraPreviewGeometryPass->GetSpecification().TargetFramebuffer->Resize(width, height);
+            s_Data.CameraPreviewCompositePass->GetSpecification().TargetFramebuffer->Resize(width, height);
+            s_Data.CameraPreviewValid = false;
+        }
+    }
+}
 
-        baseMaterial->Set("u_ViewProjection", viewProj);
-        if (shaderType == ShaderType::StandardStatic || shaderType == ShaderType::StandardAnimated)
+void SceneRenderer::UpdateResolutionScale()
+{
+    const auto& options = s_Data.Options;
+    if (options.DynamicResolution)
+    {
+        // Render graph passes are profiled under their own names
+        float gpuTime = Renderer::GetGPUProfiler()->GetMilliseconds("Geometry");
+        if (gpuTime > 0.0f && (gpuTime > options.TargetGPUTime * 1.05f || gpuTime < options.TargetGPUTime * 0.85f))
         {
-            baseMaterial->Set("u_ViewPosition", cameraPosition);
+            // Cost scales with pixel count, so the linear scale follows the square root of the budget ratio
+            float idealScale = s_Data.ResolutionScale * glm::sqrt(options.TargetGPUTime / gpuTime);
+            s_Data.ResolutionScale = glm::mix(s_Data.ResolutionScale, idealScale, 0.1f);
+        }
 
-            baseMaterial->Set("u_IrradianceTexture", s_Data.SceneData.SceneEnvironment.IrradianceMap);
-            baseMaterial->Set("u_RadianceTexture", s_Data.SceneData.SceneEnvironment.RadianceMap);
-            baseMaterial->Set("u_BRDFLUT", s_Data.BRDFLUT);
-            baseMaterial->Set("u_EnvironmentRotation", s_Data.SceneData.SceneEnvironment.Rotation);
+        s_Data.ResolutionScale = glm::clamp(s_Data.ResolutionScale, options.MinResolutionScale, options.MaxResolutionScale);
+    }
+    else
+    {
+        s_Data.ResolutionScale = 1.0f;
+    }
 
-            struct LightUniform
-            {
-                glm::vec3 Radiance;
-                float Multiplier;
-            };
-            LightUniform light{ s_Data.SceneData.ActiveLight.Radiance, s_Data.SceneData.ActiveLight.Multiplier };
+    s_Data.RenderWidth = glm::max((uint32_t)(s_Data.ViewportWidth * s_Data.ResolutionScale), 1u);
+    s_Data.RenderHeight = glm::max((uint32_t)(s_Data.ViewportHeight * s_Data.ResolutionScale), 1u);
+}
 
-            baseMaterial->Set("u_LightDirection", s_Data.SceneData.ActiveLight.Direction);
-            baseMaterial->Set("u_Light", light);
-        }
+void SceneRenderer::UpdateRenderTargetFormats()
+{
+    auto updateFormat = [](Ref<RenderPass> renderPass, FramebufferFormat format) {
+        if (!renderPass)
+            return false;
+
+        auto& framebuffer = renderPass->GetSpecification().TargetFramebuffer;
+        if (framebuffer->GetSpecification().Format == format)
+            return false;
+
+        framebuffer->GetSpecification().Format = format;
+        framebuffer->Reset();
+        return true;
+    };
 
-        Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Material);
+    const auto& options = s_Data.Options;
+    updateFormat(s_Data.GeometryPass, options.SceneColorFormat);
+    updateFormat(s_Data.CompositePass, GetCompositeFormat());
+    updateFormat(s_Data.CameraPreviewGeometryPass, options.SceneColorFormat);
+    if (updateFormat(s_Data.CameraPreviewCompositePass, GetCompositeFormat()))
+        s_Data.CameraPreviewValid = false;
+
+    for (auto& taaPass : s_Data.TAAPasses)
+    {
+        if (updateFormat(taaPass, options.SceneColorFormat))
+            s_Data.TAAHistoryValid = false;
     }
+}
+
+void SceneRenderer::UpdateAntiAliasing()
+{
+    const auto& options = s_Data.Options;
+    auto& geoFramebuffer = s_Data.GeometryPass->GetSpecification().TargetFramebuffer;
+    auto& geoSpec = geoFramebuffer->GetSpecification();
 
-    if (!s_Data.SelectedDrawList.empty())
+    uint32_t samples = 1;
+    if (options.AntiAliasing == AntiAliasingMethod::MSAA)
+        samples = glm::clamp(options.MSAASamples, 1u, (uint32_t)RendererAPI::GetCapabilities().MaxTextureSamples);
+
+    if (geoSpec.Samples != samples)
     {
-        RenderCommand::SetStencilFunction(ComparisonFunc::Always, 1, 0xff);
-        RenderCommand::SetStencilMask(0xff);
-        RenderCommand::SetStencilOperation(StencilOperation::Keep, StencilOperation::Keep, StencilOperation::Replace);
+        geoSpec.Samples = samples;
+        geoFramebuffer->Reset();
+    }
 
-        for (auto& drawCommand : s_Data.SelectedDrawList)
+    // History has to survive across frames, so it is owned here rather than taken from the transient pool
+    if (options.AntiAliasing == AntiAliasingMethod::TAA)
+    {
+        if (!s_Data.TAAPasses[0])
         {
-            auto baseMaterial = drawCommand.Mesh->GetMaterial();
-            auto shaderType = baseMaterial->GetShader()->GetType();
-
-            baseMaterial->Set("u_ViewProjection", viewProj);
-            if (shaderType == ShaderType::StandardStatic || shaderType == ShaderType::StandardAnimated)
+            for (auto& taaPass : s_Data.TAAPasses)
             {
-                baseMaterial->Set("u_ViewPosition", cameraPosition);
-
-                baseMaterial->Set("u_IrradianceTexture", s_Data.SceneData.SceneEnvironment.IrradianceMap);
-                baseMaterial->Set("u_RadianceTexture", s_Data.SceneData.SceneEnvironment.RadianceMap);
-                baseMaterial->Set("u_BRDFLUT", s_Data.BRDFLUT);
-                baseMaterial->Set("u_EnvironmentRotation", s_Data.SceneData.SceneEnvironment.Rotation);
-
-                struct LightUniform
-                {
-                    glm::vec3 Radiance;
-                    float Multiplier;
-                };
-                LightUniform light{ s_Data.SceneData.ActiveLight.Radiance, s_Data.SceneData.ActiveLight.Multiplier };
-
-                baseMaterial->Set("u_LightDirection", s_Data.SceneData.ActiveLight.Direction);
-                baseMaterial->Set("u_Light", light);
+                RenderPassSpecification taaRenderPassSpec;
+                taaRenderPassSpec.TargetFramebuffer = Framebuffer::Create(GetColorTargetSpecification(geoSpec.Width, geoSpec.Height, options.SceneColorFormat));
+                taaRenderPassSpec.DebugName = "TAAResolve";
+                taaPass = RenderPass::Create(taaRenderPassSpec);
             }
-
-            Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Material);
+            s_Data.TAAHistoryValid = false;
         }
+    }
+    else
+    {
+        for (auto& taaPass : s_Data.TAAPasses)
+            taaPass = nullptr;
+    }
+}
 
-        if (!s_Data.Options.ShowBoundingBoxes)
-        {
-            s_Data.OutlineMaterial->Set("u_ViewProjection", viewProj);
-            s_Data.OutlineMaterial->Set("u_Color", glm::vec3(1.0f, 0.2f, 0.0f));
-            s_Data.OutlineAnimatedMaterial->Set("u_ViewProjection", viewProj);
-            s_Data.OutlineAnimatedMaterial->Set("u_Color", glm::vec3(1.0f, 0.2f, 0.0f));
-
-            RenderCommand::SetStencilFunction(ComparisonFunc::NotEqual, 1, 0xff);
-            RenderCommand::SetStencilMask(0);
+void SceneRenderer::GeometryPass()
+{
+    Renderer::BeginRenderPass(s_Data.GeometryPass);
+    RenderCommand::SetViewPort(0, 0, s_Data.RenderWidth, s_Data.RenderHeight);
+    RenderCommand::SetStencilMask(0);
 
-            RenderCommand::SetLineThickness(7.0f);
-            RenderCommand::SetRasterizationMode(RasterizationMode::Line);
+    glm::mat4 projection = s_Data.SceneData.SceneCamera.Camera.GetProjectionMatrix();
+    s_Data.ViewProjection = projection * s_Data.SceneData.SceneCamera.ViewMatrix;
 
-            for (auto& drawCommand : s_Data.SelectedDrawList)
-                Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Mesh->IsAnimated() ? s_Data.OutlineAnimatedMaterial : s_Data.OutlineMaterial);
+    if (s_Data.Options.AntiAliasing == AntiAliasingMethod::TAA)
+    {
+        // Sub-pixel Halton(2, 3) jitter, applied in NDC so it works for any projection
+        s_Data.TAAFrameIndex = (s_Data.TAAFrameIndex + 1) % 8;
+        glm::vec2 jitter(Halton(s_Data.TAAFrameIndex + 1, 2) - 0.5f, Halton(s_Data.TAAFrameIndex + 1, 3) - 0.5f);
+        jitter *= glm::vec2(2.0f / s_Data.RenderWidth, 2.0f / s_Data.RenderHeight);
+        projection = glm::translate(glm::mat4(1.0f), glm::vec3(jitter, 0.0f)) * projection;
+    }
 
-            RenderCommand::SetPointSize(7.0f);
-            RenderCommand::SetRasterizationMode(RasterizationMode::Point);
+    auto viewProj = projection * s_Data.SceneData.SceneCamera.ViewMatrix;
+    glm::vec3 cameraPosition = glm::inverse(s_Data.SceneData.SceneCamera.ViewMatrix)[3];
 
-            for (auto& drawCommand : s_Data.SelectedDrawList)
-                Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Mesh->IsAnimated() ? s_Data.OutlineAnimatedMaterial : s_Data.OutlineMaterial);
+    // Render entities
+    for (auto& drawCommand : s_Data.MeshDrawList)
+    {
+        SetSceneUniforms(drawCommand.Mesh->GetMaterial(), viewProj, cameraPosition);
+        Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Material, drawCommand.LOD, drawCommand.ObjectIndex);
+    }
 
-            RenderCommand::SetStencilFunction(ComparisonFunc::Always, 1, 0xff);
-            RenderCommand::SetStencilMask(0xff);
-            RenderCommand::SetRasterizationMode(RasterizationMode::Fill);
-        }
+    for (auto& drawCommand : s_Data.SelectedDrawList)
+    {
+        SetSceneUniforms(drawCommand.Mesh->GetMaterial(), viewProj, cameraPosition);
+        Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Material, drawCommand.LOD, drawCommand.ObjectIndex);
     }
 
+    DrawStaticBatch(viewProj, cameraPosition);
+    DrawSkybox(viewProj);
+
+    // Blended sprites and overlays (grid included) go after the sky so they blend over it
     Renderer2D::BeginScene(viewProj);
 
     for (auto& quadData : s_Data.SpriteDrawList)
@@ -290,8 +662,12 @@ void SceneRenderer::GeometryPass()
             Renderer::DrawAABB(drawCommand.Mesh, drawCommand.Transform, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
     }
 
+    // The grid is a world-space plane, so it can't sit at the far plane like the sky. It is depth tested
+    // against the opaque geometry instead, and drawn last so it blends over the sky and the sprites.
     if (s_Data.Options.ShowGrid)
     {
+        Renderer::GetGPUProfiler()->BeginScope("Grid");
+
         s_Data.GridMaterial->Set("u_ViewProjection", viewProj);
         s_Data.GridMaterial->Set("u_Resolution", s_Data.Options.GridResolution);
         s_Data.GridMaterial->Set("u_Scale", s_Data.Options.GridScale);
@@ -300,93 +676,584 @@ void SceneRenderer::GeometryPass()
         gridTransform = glm::rotate(gridTransform, glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
         gridTransform = glm::scale(gridTransform, glm::vec3(s_Data.Options.GridSize * 0.5f));   // DrawQuad uses fullscreen quad, which is 2x2
         Renderer2D::DrawQuad(s_Data.GridMaterial, gridTransform);
+
+        Renderer::GetGPUProfiler()->EndScope();
     }
 
     Renderer2D::EndScene();
     Renderer::EndRenderPass();
 }
 
+void SceneRenderer::SelectionOutlinePass()
+{
+    auto& graph = s_Data.Graph;
+    auto& maskFramebuffer = graph.GetFramebuffer("SelectionMask");
+    Ref<Framebuffer> jumpFloodFramebuffers[2] = { graph.GetFramebuffer("JumpFloodA"), graph.GetFramebuffer("JumpFloodB") };
+
+    auto& jumpFloodPasses = s_Data.JumpFloodPasses;
+    s_Data.SelectionMaskPass->GetSpecification().TargetFramebuffer = maskFramebuffer;
+    for (uint32_t i = 0; i < 2; i++)
+        jumpFloodPasses[i]->GetSpecification().TargetFramebuffer = jumpFloodFramebuffers[i];
+
+    // Selected meshes are drawn once into a mask; the outline is then grown in screen space
+    Renderer::BeginRenderPass(s_Data.SelectionMaskPass);
+    RenderCommand::SetViewPort(0, 0, s_Data.RenderWidth, s_Data.RenderHeight);
+
+    s_Data.OutlineMaterial->Set("u_ViewProjection", s_Data.ViewProjection);
+    s_Data.OutlineMaterial->Set("u_Color", glm::vec3(1.0f));
+    s_Data.OutlineAnimatedMaterial->Set("u_ViewProjection", s_Data.ViewProjection);
+    s_Data.OutlineAnimatedMaterial->Set("u_Color", glm::vec3(1.0f));
+
+    for (auto& drawCommand : s_Data.SelectedDrawList)
+        Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Mesh->IsAnimated() ? s_Data.OutlineAnimatedMaterial : s_Data.OutlineMaterial, drawCommand.LOD, drawCommand.ObjectIndex);
+
+    Renderer::EndRenderPass();
+
+    // Offsets only need to reach as far as the outline width, so the flood starts at that step size
+    uint32_t width = glm::max((uint32_t)glm::ceil(s_Data.Options.SelectionOutlineWidth * s_Data.ResolutionScale), 1u);
+    uint32_t step = 1;
+    while (step < width)
+        step *= 2;
+
+    Renderer::BeginRenderPass(jumpFloodPasses[0], false);
+    RenderCommand::SetViewPort(0, 0, s_Data.RenderWidth, s_Data.RenderHeight);
+    s_Data.JumpFloodInitMaterial->Set("u_MaskTexture", maskFramebuffer->GetColorAttachments()[0]);
+    Renderer::DrawFullscreenQuad(s_Data.JumpFloodInitMaterial);
+    Renderer::EndRenderPass();
+
+    uint32_t source = 0;
+    for (; step > 0; step /= 2)
+    {
+        Renderer::BeginRenderPass(jumpFloodPasses[1 - source], false);
+        RenderCommand::SetViewPort(0, 0, s_Data.RenderWidth, s_Data.RenderHeight);
+
+        s_Data.JumpFloodMaterial->Set("u_Texture", jumpFloodFramebuffers[source]->GetColorAttachments()[0]);
+        s_Data.JumpFloodMaterial->Set("u_RenderSize", glm::vec2((float)s_Data.RenderWidth, (float)s_Data.RenderHeight));
+        s_Data.JumpFloodMaterial->Set("u_Step", (int)step);
+        Renderer::DrawFullscreenQuad(s_Data.JumpFloodMaterial);
+
+        Renderer::EndRenderPass();
+        source = 1 - source;
+    }
+
+    s_Data.SelectionMask = maskFramebuffer->GetColorAttachments()[0];
+    s_Data.SelectionDistanceField = jumpFloodFramebuffers[source]->GetColorAttachments()[0];
+
+    // Don't hold pooled targets past the frame, the submitted commands keep their own references
+    s_Data.SelectionMaskPass->GetSpecification().TargetFramebuffer = nullptr;
+    for (auto& jumpFloodPass : jumpFloodPasses)
+        jumpFloodPass->GetSpecification().TargetFramebuffer = nullptr;
+}
+
+void SceneRenderer::ResolvePass()
+{
+    auto& graph = s_Data.Graph;
+    auto& geoFramebuffer = graph.GetFramebuffer("SceneGeometry");
+    const auto& geoSpec = geoFramebuffer->GetSpecification();
+    glm::vec2 viewportScale((float)s_Data.RenderWidth / geoSpec.Width, (float)s_Data.RenderHeight / geoSpec.Height);
+
+    if (geoSpec.Samples > 1)
+    {
+        auto& resolveFramebuffer = graph.GetFramebuffer("ResolvedColor");
+        geoFramebuffer->BlitTo(resolveFramebuffer, s_Data.RenderWidth, s_Data.RenderHeight);
+        s_Data.SceneColor = resolveFramebuffer->GetColorAttachments()[0];
+    }
+    else
+    {
+        auto& taaPass = s_Data.TAAPasses[s_Data.TAAHistoryIndex];
+        auto& historyFramebuffer = graph.GetFramebuffer("TAAHistory");
+
+        Renderer::BeginRenderPass(taaPass, false);
+        RenderCommand::SetViewPort(0, 0, s_Data.RenderWidth, s_Data.RenderHeight);
+
+        s_Data.TAAMaterial->Set("u_Texture", geoFramebuffer->GetColorAttachments()[0]);
+        s_Data.TAAMaterial->Set("u_HistoryTexture", historyFramebuffer->GetColorAttachments()[0]);
+        s_Data.TAAMaterial->Set("u_DepthTexture", geoFramebuffer->GetDepthTexture());
+        s_Data.TAAMaterial->Set("u_ReprojectionMatrix", s_Data.PreviousViewProjection * glm::inverse(s_Data.ViewProjection));
+        s_Data.TAAMaterial->Set("u_ViewportScale", viewportScale);
+        s_Data.TAAMaterial->Set("u_HistoryViewportScale", s_Data.PreviousViewportScale);
+        s_Data.TAAMaterial->Set("u_BlendFactor", s_Data.TAAHistoryValid ? s_Data.Options.TAABlendFactor : 1.0f);
+        Renderer::DrawFullscreenQuad(s_Data.TAAMaterial);
+
+        Renderer::EndRenderPass();
+
+        s_Data.SceneColor = graph.GetFramebuffer("TAAOutput")->GetColorAttachments()[0];
+        s_Data.PreviousViewProjection = s_Data.ViewProjection;
+        s_Data.PreviousViewportScale = viewportScale;
+        s_Data.TAAHistoryValid = true;
+        s_Data.TAAHistoryIndex = 1 - s_Data.TAAHistoryIndex;
+    }
+}
+
 void SceneRenderer::CompositePass()
 {
     Renderer::BeginRenderPass(s_Data.CompositePass);
 
-    auto material = Ref<MaterialInstance>::Create(s_Data.CompositeBaseMaterial);
+    const auto& geoSpec = s_Data.GeometryPass->GetSpecification().TargetFramebuffer->GetSpecification();
+
+    // Without a resolve pass the geometry target is composited directly
+    if (!s_Data.SceneColor)
+        s_Data.SceneColor = s_Data.Graph.GetFramebuffer("SceneGeometry")->GetColorAttachments()[0];
+
+    auto& material = s_Data.CompositeMaterial;
     material->Set("u_Exposure", s_Data.SceneData.SceneCamera.Camera.GetExposure());
-    material->Set("u_Texture", s_Data.GeometryPass->GetSpecification().TargetFramebuffer->GetColorAttachments()[0]);
-    material->Set("u_TextureSamples", s_Data.GeometryPass->GetSpecification().TargetFramebuffer->GetSpecification().Samples);
+    material->Set("u_Texture", s_Data.SceneColor);
+    material->Set("u_ViewportScale", glm::vec2((float)s_Data.RenderWidth / geoSpec.Width, (float)s_Data.RenderHeight / geoSpec.Height));
+    material->Set("u_FXAA", s_Data.Options.AntiAliasing == AntiAliasingMethod::FXAA ? 1 : 0);
+
+    Renderer::DrawFullscreenQuad(material);
+
+    if (s_Data.SelectionDistanceField)
+    {
+        s_Data.JumpFloodOutlineMaterial->Set("u_Texture", s_Data.SelectionDistanceField);
+        s_Data.JumpFloodOutlineMaterial->Set("u_MaskTexture", s_Data.SelectionMask);
+        s_Data.JumpFloodOutlineMaterial->Set("u_ViewportScale", glm::vec2((float)s_Data.RenderWidth / geoSpec.Width, (float)s_Data.RenderHeight / geoSpec.Height));
+        s_Data.JumpFloodOutlineMaterial->Set("u_Color", s_Data.Options.SelectionOutlineColor);
+        s_Data.JumpFloodOutlineMaterial->Set("u_Width", s_Data.Options.SelectionOutlineWidth * s_Data.ResolutionScale);
+        Renderer::DrawFullscreenQuad(s_Data.JumpFloodOutlineMaterial);
+    }
+
+    Renderer::EndRenderPass();
+}
+
+void SceneRenderer::CameraPreviewPass()
+{
+    const auto& camera = s_Data.CameraPreviewCamera;
+    auto viewProj = camera.Camera.GetProjectionMatrix() * camera.ViewMatrix;
+    glm::vec3 cameraPosition = glm::inverse(camera.ViewMatrix)[3];
+
+    // Same draw lists as the main view, without editor overlays
+    Renderer::BeginRenderPass(s_Data.CameraPreviewGeometryPass);
+
+    for (auto& drawCommand : s_Data.MeshDrawList)
+    {
+        SetSceneUniforms(drawCommand.Mesh->GetMaterial(), viewProj, cameraPosition);
+        Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Material, drawCommand.LOD, drawCommand.ObjectIndex);
+    }
+
+    for (auto& drawCommand : s_Data.SelectedDrawList)
+    {
+        SetSceneUniforms(drawCommand.Mesh->GetMaterial(), viewProj, cameraPosition);
+        Renderer::DrawMesh(drawCommand.Mesh, drawCommand.Transform, drawCommand.Material, drawCommand.LOD, drawCommand.ObjectIndex);
+    }
+
+    DrawStaticBatch(viewProj, cameraPosition);
+    DrawSkybox(viewProj);
+
+    Renderer2D::BeginScene(viewProj);
+    for (auto& quadData : s_Data.SpriteDrawList)
+        Renderer2D::DrawQuad(quadData);
+    Renderer2D::EndScene();
+
+    Renderer::EndRenderPass();
+
+    Renderer::BeginRenderPass(s_Data.CameraPreviewCompositePass);
 
+    auto& material = s_Data.CameraPreviewCompositeMaterial;
+    material->Set("u_Exposure", camera.Camera.GetExposure());
+    material->Set("u_Texture", s_Data.CameraPreviewGeometryPass->GetSpecification().TargetFramebuffer->GetColorAttachments()[0]);
+    material->Set("u_ViewportScale", glm::vec2(1.0f));
+    material->Set("u_FXAA", 0);
     Renderer::DrawFullscreenQuad(material);
 
     Renderer::EndRenderPass();
 }
 
+void SceneRenderer::UpdateEnvironmentJobs()
+{
+    uint32_t steps = s_Data.Options.EnvironmentStepsPerFrame;
+    auto it = s_Data.EnvironmentJobs.begin();
+    while (it != s_Data.EnvironmentJobs.end() && steps > 0)
+    {
+        Renderer::GetGPUProfiler()->BeginScope("EnvironmentMap");
+        bool complete = (*it)->Step();
+        Renderer::GetGPUProfiler()->EndScope();
+
+        if (complete)
+            it = s_Data.EnvironmentJobs.erase(it);
+        steps--;
+    }
+}
+
+void SceneRenderer::BuildRenderGraph()
+{
+    auto& graph = s_Data.Graph;
+    graph.Reset();
+
+    const auto& geoFramebuffer = s_Data.GeometryPass->GetSpecification().TargetFramebuffer;
+    const auto& geoSpec = geoFramebuffer->GetSpecification();
+
+    graph.ImportFramebuffer("SceneGeometry", geoFramebuffer);
+    graph.ImportFramebuffer("SceneComposite", s_Data.CompositePass->GetSpecification().TargetFramebuffer);
+    graph.MarkOutput("SceneComposite");
+
+    graph.AddPass("Geometry",
+        [](RenderGraph::PassBuilder& builder) { builder.Write("SceneGeometry"); },
+        [](RenderGraph&) { GeometryPass(); });
+
+    std::vector<std::string> compositeInputs = { "SceneGeometry" };
+
+    if (!s_Data.SelectedDrawList.empty() && !s_Data.Options.ShowBoundingBoxes)
+    {
+        auto maskSpec = GetColorTargetSpecification(geoSpec.Width, geoSpec.Height);
+        maskSpec.Format = FramebufferFormat::RGBA8;
+        maskSpec.ClearColor = { 0.0f, 0.0f, 0.0f, 0.0f };
+        graph.CreateFramebuffer("SelectionMask", maskSpec);
+        // Seed coordinates need the float precision
+        graph.CreateFramebuffer("JumpFloodA", GetColorTargetSpecification(geoSpec.Width, geoSpec.Height));
+        graph.CreateFramebuffer("JumpFloodB", GetColorTargetSpecification(geoSpec.Width, geoSpec.Height));
+
+        graph.AddPass("SelectionOutline",
+            [](RenderGraph::PassBuilder& builder)
+            {
+                builder.Write("SelectionMask");
+                builder.Write("JumpFloodA");
+                builder.Write("JumpFloodB");
+            },
+            [](RenderGraph&) { SelectionOutlinePass(); });
+
+        compositeInputs.insert(compositeInputs.end(), { "SelectionMask", "JumpFloodA", "JumpFloodB" });
+    }
+
+    if (geoSpec.Samples > 1)
+    {
+        graph.CreateFramebuffer("ResolvedColor", GetColorTargetSpecification(geoSpec.Width, geoSpec.Height, geoSpec.Format));
+        graph.AddPass("Resolve",
+            [](RenderGraph::PassBuilder& builder)
+            {
+                builder.Read("SceneGeometry");
+                builder.Write("ResolvedColor");
+            },
+            [](RenderGraph&) { ResolvePass(); });
+
+        compositeInputs.push_back("ResolvedColor");
+    }
+    else if (s_Data.TAAPasses[0])
+    {
+        graph.ImportFramebuffer("TAAOutput", s_Data.TAAPasses[s_Data.TAAHistoryIndex]->GetSpecification().TargetFramebuffer);
+        graph.ImportFramebuffer("TAAHistory", s_Data.TAAPasses[1 - s_Data.TAAHistoryIndex]->GetSpecification().TargetFramebuffer);
+        graph.AddPass("TemporalAA",
+            [](RenderGraph::PassBuilder& builder)
+            {
+                builder.Read("SceneGeometry");
+                builder.Read("TAAHistory");
+                builder.Write("TAAOutput");
+            },
+            [](RenderGraph&) { ResolvePass(); });
+
+        compositeInputs.push_back("TAAOutput");
+    }
+
+    graph.AddPass("Composite",
+        [compositeInputs](RenderGraph::PassBuilder& builder)
+        {
+            for (auto& input : compositeInputs)
+                builder.Read(input);
+            builder.Write("SceneComposite");
+        },
+        [](RenderGraph&) { CompositePass(); });
+
+    // The preview only becomes an output of the graph on frames where it is due for a refresh
+    if (s_Data.CameraPreviewRequested)
+    {
+        s_Data.CameraPreviewRequested = false;
+
+        graph.ImportFramebuffer("CameraPreviewGeometry", s_Data.CameraPreviewGeometryPass->GetSpecification().TargetFramebuffer);
+        graph.ImportFramebuffer("CameraPreviewComposite", s_Data.CameraPreviewCompositePass->GetSpecification().TargetFramebuffer);
+        graph.AddPass("CameraPreview",
+            [](RenderGraph::PassBuilder& builder)
+            {
+                builder.Write("CameraPreviewGeometry");
+                builder.Write("CameraPreviewComposite");
+            },
+            [](RenderGraph&) { CameraPreviewPass(); });
+
+        double time = Time::TimeSinceInit();
+        if (!s_Data.CameraPreviewValid || time - s_Data.CameraPreviewRefreshTime >= 1.0 / s_Data.Options.CameraPreviewRefreshRate)
+        {
+            s_Data.CameraPreviewRefreshTime = time;
+            s_Data.CameraPreviewValid = true;
+            graph.MarkOutput("CameraPreviewComposite");
+        }
+    }
+
+    graph.Compile();
+}
+
 void SceneRenderer::FlushDrawList()
 {
-    GeometryPass();
-    CompositePass();
+    UpdateResolutionScale();
+    UpdateRenderTargetFormats();
+    UpdateAntiAliasing();
+
+    // Bound for the whole frame, the standard shaders index it per draw
+    s_Data.GPUScene->Bind();
+
+    BuildRenderGraph();
+    s_Data.Graph.Execute();
+
+    UpdateEnvironmentJobs();
 
     s_Data.MeshDrawList.clear();
     s_Data.SelectedDrawList.clear();
+    s_Data.StaticBatch = nullptr;
+    s_Data.GPUScene = nullptr;
     s_Data.CameraDrawList.clear();
     s_Data.SpriteDrawList.clear();
     s_Data.SceneData = {};
+    s_Data.SceneColor = nullptr;
+    s_Data.SelectionMask = nullptr;
+    s_Data.SelectionDistanceField = nullptr;
 }
 
-std::pair<Ref<TextureCube>, Ref<TextureCube>> SceneRenderer::CreateEnvironmentMap(const std::string& filepath)
+EnvironmentMapJob::EnvironmentMapJob(const std::string& filepath, const EnvironmentSettings& settings)
 {
-    const uint32_t cubemapSize = 2048;
+    AB_CORE_ASSERT(settings.CubemapSize >= 32 && (settings.CubemapSize & (settings.CubemapSize - 1)) == 0, "Cubemap size must be a power of two!");
+
+    m_Environment.Filepath = filepath;
+    m_Environment.Settings = settings;
+
+    // Textures created here only record their uploads, the queue is executed once the job picks up the result
+    m_Load = std::async(std::launch::async, [filepath, settings]() {
+        LoadResult result;
+        result.Uploads = CreateScope<RenderCommandQueue>(16 * 1024);
+        RenderCommand::BeginRecording(*result.Uploads);
+
+        if (settings.UseIrradianceSH)
+            result.IrradianceSH = SceneRenderer::CreateIrradianceSH(filepath, settings);
+
+        result.CachePath = EnvironmentCache::GetCachePath(filepath, settings);
+        if (!result.CachePath.empty())
+        {
+            result.CachedIrradiance = settings.UseIrradianceSH ? nullptr : EnvironmentCache::Load(result.CachePath + ".irradiance.dds");
+            result.CachedRadiance = EnvironmentCache::Load(result.CachePath + ".radiance.dds");
+        }
+
+        if (!result.CachedRadiance || (!result.CachedIrradiance && !settings.UseIrradianceSH))
+            result.EquirectangularTexture = Texture2D::Create(filepath, false, false);
+
+        RenderCommand::EndRecording();
+        return result;
+    });
+}
+
+void EnvironmentMapJob::OnLoaded(LoadResult result)
+{
+    RenderCommand::ExecuteQueue(std::move(result.Uploads));
+
+    const EnvironmentSettings& settings = m_Environment.Settings;
+    m_Environment.IrradianceSH = result.IrradianceSH;
+    if (!result.EquirectangularTexture)
+    {
+        m_Environment.IrradianceMap = result.CachedIrradiance;
+        m_Environment.RadianceMap = result.CachedRadiance;
+        return;
+    }
+
+    const std::string& cachePath = result.CachePath;
+    const uint32_t cubemapSize = settings.CubemapSize;
     const uint32_t irradianceSize = 32;
+    const int sampleCount = (int)settings.SampleCount;
 
-    // Equirectangular to cubemap
-    Ref<Texture2D> equiTexture = Texture2D::Create(filepath, false, false);
+    Ref<Texture2D> equiTexture = result.EquirectangularTexture;
     AB_CORE_ASSERT(equiTexture->GetFormat() == TextureFormat::Float16, "Equirectangular texture is not HDR!");
     Ref<TextureCube> cubemapTexture = TextureCube::Create(TextureFormat::Float16, cubemapSize, cubemapSize);
+    Ref<TextureCube> radianceTexture = TextureCube::Create(TextureFormat::Float16, cubemapSize, cubemapSize);
+    Ref<TextureCube> irradianceTexture = settings.UseIrradianceSH ? nullptr : TextureCube::Create(TextureFormat::Float16, irradianceSize, irradianceSize);
 
-    s_Data.ShaderLibrary->Get("EquirectangularToCubemap")->Bind();
-    equiTexture->Bind();
-    RenderCommand::Submit([equiTexture, cubemapTexture, cubemapSize]() {
-        glBindImageTexture(0, cubemapTexture->GetRendererID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
-        glDispatchCompute(cubemapSize / 32, cubemapSize / 32, 6);
-        glGenerateTextureMipmap(cubemapTexture->GetRendererID());
-    });
-
-    // Irradiance texture
-    Ref<TextureCube> irradianceTexture = TextureCube::Create(TextureFormat::Float16, irradianceSize, irradianceSize);
+    // Equirectangular to cubemap, one face per step
+    const uint32_t fetchAndUpdate = (uint32_t)BarrierType::TextureFetch | (uint32_t)BarrierType::TextureUpdate;
+    auto equirectPipeline = ComputePipeline::Create({ s_Data.ShaderLibrary->Get("EquirectangularToCubemap") });
+    for (int face = 0; face < 6; face++)
+    {
+        m_Steps.push_back([equirectPipeline, equiTexture, cubemapTexture, cubemapSize, face, fetchAndUpdate]() {
+            equirectPipeline->Bind();
+            equirectPipeline->BindTexture(0, equiTexture);
+            equirectPipeline->BindImage(0, cubemapTexture);
+            equirectPipeline->SetInt(0, face);
+            equirectPipeline->Dispatch(cubemapSize / 32, cubemapSize / 32, 1);
+            RenderCommand::Barrier(fetchAndUpdate);
+            return true;
+        });
+    }
 
-    s_Data.ShaderLibrary->Get("EnvironmentIrradiance")->Bind();
-    cubemapTexture->Bind();
-    RenderCommand::Submit([irradianceTexture, cubemapTexture, irradianceSize]() {
-        glBindImageTexture(0, irradianceTexture->GetRendererID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
-        glDispatchCompute(irradianceSize / 32, irradianceSize / 32, 6);
-        glGenerateTextureMipmap(irradianceTexture->GetRendererID());
+    m_Steps.push_back([cubemapTexture]() {
+        RenderCommand::Submit([cubemapTexture]() {
+            glGenerateTextureMipmap(cubemapTexture->GetRendererID());
+        });
+        return true;
     });
 
+    // Irradiance texture, not needed when the environment uses spherical harmonics instead
+    if (irradianceTexture)
+    {
+        auto irradiancePipeline = ComputePipeline::Create({ s_Data.ShaderLibrary->Get("EnvironmentIrradiance") });
+        m_Steps.push_back([irradiancePipeline, irradianceTexture, cubemapTexture, irradianceSize]() {
+            irradiancePipeline->Bind();
+            irradiancePipeline->BindTexture(0, cubemapTexture);
+            irradiancePipeline->BindImage(0, irradianceTexture);
+            irradiancePipeline->Dispatch(irradianceSize / 32, irradianceSize / 32, 6);
+            RenderCommand::Barrier((uint32_t)BarrierType::TextureUpdate);
+            RenderCommand::Submit([irradianceTexture]() {
+                glGenerateTextureMipmap(irradianceTexture->GetRendererID());
+            });
+            return true;
+        });
+    }
+
     // Prefiltered environment (radiance) texture
-    Ref<TextureCube> radianceTexture = TextureCube::Create(TextureFormat::Float16, cubemapSize, cubemapSize);
-    RenderCommand::Submit([radianceTexture, cubemapTexture]() {
-        glCopyImageSubData(
-            cubemapTexture->GetRendererID(), GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0,
-            radianceTexture->GetRendererID(), GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0,
-            cubemapTexture->GetWidth(), cubemapTexture->GetHeight(), 6);
+    m_Steps.push_back([radianceTexture, cubemapTexture]() {
+        RenderCommand::Submit([radianceTexture, cubemapTexture]() {
+            glCopyImageSubData(
+                cubemapTexture->GetRendererID(), GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0,
+                radianceTexture->GetRendererID(), GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0,
+                cubemapTexture->GetWidth(), cubemapTexture->GetHeight(), 6);
+        });
+        return true;
     });
 
-    auto filteringShader = s_Data.ShaderLibrary->Get("EnvironmentMipFilter");
-    filteringShader->Bind();
-    cubemapTexture->Bind();
-    RenderCommand::Submit([radianceTexture, cubemapTexture, cubemapSize, filteringShader]() {
-        const uint32_t mipCount = radianceTexture->GetMipLevelCount();
-        const float deltaRoughness = 1.0f / glm::max((float)mipCount - 1.0f, 1.0f);
-        for (uint32_t level = 1, size = cubemapSize / 2; level < mipCount; level++, size /= 2)
+    // Large mip levels are filtered a face at a time, small ones in a single step
+    auto filteringPipeline = ComputePipeline::Create({ s_Data.ShaderLibrary->Get("EnvironmentMipFilter") });
+    const uint32_t mipCount = Texture::CalculateMipMapCount(cubemapSize, cubemapSize);
+    const float deltaRoughness = 1.0f / glm::max((float)mipCount - 1.0f, 1.0f);
+    for (uint32_t level = 1, size = cubemapSize / 2; level < mipCount; level++, size /= 2)
+    {
+        int faceCount = size >= 256 ? 1 : 6;
+        for (int face = 0; face < 6; face += faceCount)
         {
-            uint32_t numGroups = glm::max((uint32_t)1, size / 32);
+            m_Steps.push_back([filteringPipeline, radianceTexture, cubemapTexture, level, size, face, faceCount, sampleCount, deltaRoughness, fetchAndUpdate]() {
+                uint32_t numGroups = ComputePipeline::GetGroupCount(size, 32);
+
+                filteringPipeline->Bind();
+                filteringPipeline->BindTexture(0, cubemapTexture);
+                filteringPipeline->BindImage(0, radianceTexture, level);
+                filteringPipeline->SetFloat(0, level * deltaRoughness);
+                filteringPipeline->SetInt(1, sampleCount);
+                filteringPipeline->SetInt(2, face);
+                filteringPipeline->Dispatch(numGroups, numGroups, faceCount);
+                RenderCommand::Barrier(fetchAndUpdate);
+                return true;
+            });
+        }
+    }
 
-            glBindImageTexture(0, radianceTexture->GetRendererID(), level, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
-            glProgramUniform1f(filteringShader->GetRendererID(), 0, level * deltaRoughness);
-            glDispatchCompute(numGroups, numGroups, 6);
+    // Maps are only handed out once every step has been submitted, the cache is written after that
+    m_Steps.push_back([this, irradianceTexture, radianceTexture, cachePath]() {
+        m_Environment.IrradianceMap = irradianceTexture;
+        m_Environment.RadianceMap = radianceTexture;
+
+        if (!cachePath.empty())
+        {
+            if (irradianceTexture)
+                m_CacheWrites.push_back(Ref<EnvironmentCacheWrite>::Create(cachePath + ".irradiance.dds", irradianceTexture));
+            m_CacheWrites.push_back(Ref<EnvironmentCacheWrite>::Create(cachePath + ".radiance.dds", radianceTexture));
         }
+        return true;
     });
 
-    return { irradianceTexture, radianceTexture };
+    m_Steps.push_back([this]() {
+        bool written = true;
+        for (auto& write : m_CacheWrites)
+            written = write->Poll() && written;
+        return written;
+    });
+}
+
+bool EnvironmentMapJob::Step()
+{
+    if (m_Load.valid())
+    {
+        if (m_Load.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+
+        OnLoaded(m_Load.get());
+        return m_Steps.empty();
+    }
+
+    if (!m_Steps.empty() && m_Steps.front()())
+        m_Steps.pop_front();
+
+    return m_Steps.empty();
+}
+
+void EnvironmentMapJob::Run()
+{
+    if (m_Load.valid())
+        m_Load.wait();
+
+    while (!IsComplete())
+        Step();
+
+    if (!m_Steps.empty())
+        SceneRenderer::SubmitEnvironmentJob(this);
+}
+
+const Environment& EnvironmentMapJob::GetEnvironment() const
+{
+    AB_CORE_ASSERT(IsComplete(), "Environment map job has not finished!");
+    return m_Environment;
+}
+
+std::array<glm::vec3, 9> SceneRenderer::CreateIrradianceSH(const std::string& filepath, const EnvironmentSettings& settings)
+{
+    std::array<glm::vec3, 9> coefficients = {};
+
+    std::string cachePath = EnvironmentCache::GetCachePath(filepath, settings);
+    if (!cachePath.empty() && EnvironmentCache::Load(cachePath + ".sh", coefficients))
+        return coefficients;
+
+    stbi_set_flip_vertically_on_load_thread(false);
+
+    int width, height, channels;
+    float* data = stbi_loadf(filepath.c_str(), &width, &height, &channels, STBI_rgb);
+    if (!data)
+    {
+        AB_CORE_WARN("Could not load '{0}' for spherical harmonics projection", filepath);
+        return coefficients;
+    }
+
+    // L2 irradiance is very low frequency, so a few hundred texels per row are plenty
+    const int stride = glm::max(width / 512, 1);
+    const float pi = glm::pi<float>();
+    const float texelSolidAngle = (2.0f * pi / width) * (pi / height) * (float)(stride * stride);
+
+    for (int y = 0; y < height; y += stride)
+    {
+        // Same mapping as EquirectangularToCubemap.glsl
+        float theta = ((float)y + 0.5f) / height * pi;
+        float sinTheta = glm::sin(theta);
+        float cosTheta = glm::cos(theta);
+        float weight = texelSolidAngle * sinTheta;
+
+        for (int x = 0; x < width; x += stride)
+        {
+            float phi = (((float)x + 0.5f) / width - 0.5f) * 2.0f * pi;
+            glm::vec3 direction(sinTheta * glm::cos(phi), cosTheta, sinTheta * glm::sin(phi));
+            glm::vec3 radiance = glm::make_vec3(&data[((size_t)y * width + x) * 3]) * weight;
+
+            coefficients[0] += radiance * 0.282095f;
+            coefficients[1] += radiance * 0.488603f * direction.y;
+            coefficients[2] += radiance * 0.488603f * direction.z;
+            coefficients[3] += radiance * 0.488603f * direction.x;
+            coefficients[4] += radiance * 1.092548f * direction.x * direction.y;
+            coefficients[5] += radiance * 1.092548f * direction.y * direction.z;
+            coefficients[6] += radiance * 0.315392f * (3.0f * direction.z * direction.z - 1.0f);
+            coefficients[7] += radiance * 1.092548f * direction.x * direction.z;
+            coefficients[8] += radiance * 0.546274f * (direction.x * direction.x - direction.y * direction.y);
+        }
+    }
+
+    stbi_image_free(data);
+
+    // Convolve with the clamped cosine lobe so the shader can evaluate irradiance directly
+    const float bandFactors[] = { pi, 2.0f * pi / 3.0f, pi / 4.0f };
+    for (uint32_t i = 0; i < 9; i++)
+        coefficients[i] *= bandFactors[i == 0 ? 0 : (i < 4 ? 1 : 2)];
+
+    if (!cachePath.empty())
+        EnvironmentCache::Store(cachePath + ".sh", coefficients);
+
+    return coefficients;
 }
 
 Ref<RenderPass> SceneRenderer::GetFinalRenderPass()
@@ -399,6 +1266,44 @@ Ref<Texture2D> SceneRenderer::GetFinalColorBuffer()
     return s_Data.CompositePass->GetSpecification().TargetFramebuffer->GetColorAttachments()[0];
 }
 
+float SceneRenderer::GetResolutionScale()
+{
+    return s_Data.ResolutionScale;
+}
+
+SceneRenderer::Statistics SceneRenderer::GetStats()
+{
+    Statistics stats;
+    const auto& profiler = Renderer::GetGPUProfiler();
+    stats.GeometryPassGPUTime = profiler->GetMilliseconds("Geometry");
+    stats.ResolvePassGPUTime = profiler->GetMilliseconds("Resolve") + profiler->GetMilliseconds("TemporalAA");
+    stats.CompositePassGPUTime = profiler->GetMilliseconds("Composite");
+    stats.RenderGraphPasses = s_Data.Graph.GetPassCount();
+    stats.CulledRenderGraphPasses = s_Data.Graph.GetCulledPassCount();
+    stats.GPUSceneObjects = s_Data.GPUSceneObjects;
+    stats.GPUSceneUploadedObjects = s_Data.GPUSceneUploadedObjects;
+    stats.GPUSceneUploadRanges = s_Data.GPUSceneUploadRanges;
+
+    stats.RenderTargetMemory += Framebuffer::GetMemorySize(s_Data.GeometryPass->GetSpecification().TargetFramebuffer->GetSpecification());
+    for (auto& taaPass : s_Data.TAAPasses)
+    {
+        if (taaPass)
+            stats.RenderTargetMemory += Framebuffer::GetMemorySize(taaPass->GetSpecification().TargetFramebuffer->GetSpecification());
+    }
+    stats.RenderTargetMemory += Framebuffer::GetMemorySize(s_Data.CompositePass->GetSpecification().TargetFramebuffer->GetSpecification());
+    stats.RenderTargetMemory += FramebufferPool::GetGlobal()->GetMemoryUsage();
+
+    return stats;
+}
+
+Ref<Texture2D> SceneRenderer::GetCameraPreviewColorBuffer()
+{
+    if (!s_Data.CameraPreviewCompositePass)
+        return nullptr;
+
+    return s_Data.CameraPreviewCompositePass->GetSpecification().TargetFramebuffer->GetColorAttachments()[0];
+}
+
 SceneRendererOptions& SceneRenderer::GetOptions()
 {
     return s_Data.Options;
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <deque>
+#include <future>
+
 #include <glm/glm.hpp>
 
 #include "Amber/Renderer/Camera.h"
+#include "Amber/Renderer/EnvironmentCache.h"
+#include "Amber/Renderer/RenderCommandQueue.h"
 #include "Amber/Renderer/RenderPass.h"
+#include "Amber/Renderer/StaticMeshBatch.h"
 #include "Amber/Renderer/Texture.h"
 
 #include "Amber/Scene/Entity.h"
@@ -13,6 +19,11 @@
 namespace Amber
 {
 
+enum class AntiAliasingMethod
+{
+    None = 0, MSAA, FXAA, TAA
+};
+
 struct SceneRendererOptions
 {
     bool ShowGrid = true;
@@ -21,6 +32,33 @@ struct SceneRendererOptions
     float GridSize = 16.025f;
     bool ShowBoundingBoxes = false;
     bool ShowCamera = false;
+
+    glm::vec3 SelectionOutlineColor = { 1.0f, 0.2f, 0.0f };
+    float SelectionOutlineWidth = 3.0f;
+
+    bool DynamicResolution = false;
+    float TargetGPUTime = 8.0f;
+    float MinResolutionScale = 0.5f;
+    float MaxResolutionScale = 1.0f;
+
+    AntiAliasingMethod AntiAliasing = AntiAliasingMethod::MSAA;
+    uint32_t MSAASamples = 8;
+    float TAABlendFactor = 0.1f;
+
+    float CameraPreviewScale = 0.25f;
+    float CameraPreviewRefreshRate = 15.0f;
+
+    uint32_t EnvironmentStepsPerFrame = 1;
+
+    // Scene color stays HDR until the composite pass tonemaps it for display
+    FramebufferFormat SceneColorFormat = FramebufferFormat::R11G11B10F;
+    // RGBA8_SRGB needs GL_EXT_texture_sRGB_decode, RGBA8 is used in its place without it
+    FramebufferFormat CompositeFormat = FramebufferFormat::RGBA8;
+
+    // Scales projected sizes before LOD selection, above 1 keeps detail further away
+    float LODBias = 1.0f;
+    // Fraction past a LOD threshold a mesh must go before switching, avoids popping at the boundary
+    float LODHysteresis = 0.1f;
 };
 
 struct SceneRendererCamera
@@ -29,6 +67,42 @@ struct SceneRendererCamera
     glm::mat4 ViewMatrix;
 };
 
+// Builds an environment's maps incrementally, one cubemap face or mip level per step.
+// The cache, the source image and the spherical harmonics projection are loaded on a worker thread.
+class EnvironmentMapJob : public RefCounted
+{
+public:
+    EnvironmentMapJob(const std::string& filepath, const EnvironmentSettings& settings);
+
+    // Returns true once the job has nothing left to do, new maps are still written to the cache after they are complete
+    bool Step();
+    // Steps until the maps are complete, the cache is written by the environment jobs
+    void Run();
+
+    bool IsComplete() const { return m_Environment.RadianceMap; }
+    const Environment& GetEnvironment() const;
+
+private:
+    struct LoadResult
+    {
+        std::string CachePath;
+        std::array<glm::vec3, 9> IrradianceSH{};
+        Ref<TextureCube> CachedIrradiance, CachedRadiance;
+        Ref<Texture2D> EquirectangularTexture;
+        // Uploads recorded on the worker thread
+        Scope<RenderCommandQueue> Uploads;
+    };
+
+    void OnLoaded(LoadResult result);
+
+private:
+    Environment m_Environment;
+    std::future<LoadResult> m_Load;
+    std::vector<Ref<EnvironmentCacheWrite>> m_CacheWrites;
+    // A step returns false to run again, e.g. while it waits on the GPU or the disk
+    std::deque<std::function<bool()>> m_Steps;
+};
+
 class SceneRenderer
 {
 public:
@@ -39,21 +113,56 @@ public:
     static void EndScene();
 
     static void SubmitCamera(const SceneCamera& camera, const glm::mat4& transform);
-    static void SubmitMesh(const Ref<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f), const Ref<MaterialInstance> = nullptr);
-    static void SubmitSelectedMesh(const Ref<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f));
+    // lodIndex holds the mesh's level of detail between frames, it is updated from the projected size.
+    // With an objectIndex the standard shaders read the transform from the scene's GPU data instead.
+    static void SubmitMesh(const Ref<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f), const Ref<MaterialInstance> = nullptr, uint32_t* lodIndex = nullptr, int32_t objectIndex = -1);
+    static void SubmitSelectedMesh(const Ref<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f), uint32_t* lodIndex = nullptr, int32_t objectIndex = -1);
+    // Drawn this frame alongside the mesh list, see Scene::BuildStaticBatch
+    static void SubmitStaticBatch(const Ref<StaticMeshBatch>& batch);
     static void SubmitSprite(const Renderer2D::QuadData& quadData);
 
-    static std::pair<Ref<TextureCube>, Ref<TextureCube>> CreateEnvironmentMap(const std::string& filepath);
+    // Renders this frame's draw lists from another camera into a small persistent target
+    static void SubmitCameraPreview(const SceneRendererCamera& camera);
+
+    // Queued jobs are advanced by EnvironmentStepsPerFrame steps every frame
+    static void SubmitEnvironmentJob(const Ref<EnvironmentMapJob>& job);
+    static std::array<glm::vec3, 9> CreateIrradianceSH(const std::string& filepath, const EnvironmentSettings& settings = {});
 
     static Ref<RenderPass> GetFinalRenderPass();
     static Ref<Texture2D> GetFinalColorBuffer();
+    static Ref<Texture2D> GetCameraPreviewColorBuffer();
+
+    static float GetResolutionScale();
+
+    struct Statistics
+    {
+        float GeometryPassGPUTime = 0.0f;
+        float ResolvePassGPUTime = 0.0f;
+        float CompositePassGPUTime = 0.0f;
+        uint32_t RenderGraphPasses = 0;
+        uint32_t CulledRenderGraphPasses = 0;
+        uint32_t GPUSceneObjects = 0;
+        uint32_t GPUSceneUploadedObjects = 0;
+        uint32_t GPUSceneUploadRanges = 0;
+        uint64_t RenderTargetMemory = 0;
+    };
+    static Statistics GetStats();
 
     static SceneRendererOptions& GetOptions();
     static Scope<ShaderLibrary>& GetShaderLibrary();
 
 private:
+    static void UpdateResolutionScale();
+    static void UpdateAntiAliasing();
+    static void UpdateRenderTargetFormats();
+
     static void GeometryPass();
+    static void SelectionOutlinePass();
+    static void ResolvePass();
     static void CompositePass();
+    static void CameraPreviewPass();
+    static void UpdateEnvironmentJobs();
+    static void BuildRenderGraph();
     static void FlushDrawList();
 };
 
@@ -1,8 +1,11 @@
 #include "abpch.h"
 #include "Shader.h"
 
+#include <future>
+
 #include "Amber/Platform/OpenGL/OpenGLShader.h"
 
+#include "Amber/Renderer/RenderCommand.h"
 #include "Amber/Renderer/Renderer.h"
 
 namespace Amber
@@ -13,6 +16,7 @@ Ref<Shader> Shader::Create(const std::string& filepath, ShaderType type)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLShader>::Create(filepath, type);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Shaders are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -25,6 +29,7 @@ Ref<Shader> Shader::CreateFromString(const std::string& name, const std::string&
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLShader>::Create(name, source);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Shaders are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -65,6 +70,45 @@ Ref<Shader> ShaderLibrary::Load(ShaderType type, const std::string& filepath)
     return shader;
 }
 
+void ShaderLibrary::LoadBatch(std::initializer_list<std::string> filepaths)
+{
+    std::vector<std::pair<ShaderType, std::string>> shaders;
+    for (auto& filepath : filepaths)
+        shaders.emplace_back(ShaderType::None, filepath);
+
+    LoadParallel(shaders);
+}
+
+void ShaderLibrary::LoadBatch(std::initializer_list<std::pair<ShaderType, std::string>> shaders)
+{
+    LoadParallel(shaders);
+}
+
+void ShaderLibrary::LoadParallel(const std::vector<std::pair<ShaderType, std::string>>& shaders)
+{
+    AB_PROFILE_FUNCTION();
+
+    // Every worker records into its own queue, they are replayed in the order the shaders were listed
+    std::vector<Scope<RenderCommandQueue>> queues;
+    std::vector<std::future<Ref<Shader>>> loads;
+    for (auto& [type, filepath] : shaders)
+    {
+        auto& queue = queues.emplace_back(CreateScope<RenderCommandQueue>(16 * 1024));
+        loads.push_back(std::async(std::launch::async, [type = type, &filepath = filepath, queue = queue.get()]() {
+            RenderCommand::BeginRecording(*queue);
+            auto shader = Shader::Create(filepath, type);
+            RenderCommand::EndRecording();
+            return shader;
+        }));
+    }
+
+    for (auto& load : loads)
+        Add(load.get());
+
+    for (auto& queue : queues)
+        RenderCommand::ExecuteQueue(std::move(queue));
+}
+
 Ref<Shader> ShaderLibrary::Get(const std::string& name)
 {
     AB_CORE_ASSERT(Exists(name), "Shader not found!");
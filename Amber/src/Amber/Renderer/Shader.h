@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -28,6 +30,10 @@ public:
     virtual void Bind() const = 0;
     virtual void Unbind() const = 0;
 
+    // False while the driver is still compiling the shader in the background, draws skip it until then.
+    // Without background compilation this is always true and the first Bind waits for the compile.
+    virtual bool IsReady() const = 0;
+
     virtual const std::string& GetName() const = 0;
     virtual ShaderType GetType() const = 0;
     virtual uint32_t GetRendererID() const = 0;
@@ -38,11 +44,21 @@ public:
     virtual const ShaderUniformBuffer& GetVSMaterialUniformBuffer() const = 0;
     virtual const ShaderUniformBuffer& GetPSMaterialUniformBuffer() const = 0;
 
-    virtual void SetVSMaterialUniformBuffer(const Buffer& buffer) = 0;
-    virtual void SetPSMaterialUniformBuffer(const Buffer& buffer) = 0;
-
     virtual const ShaderResourceList& GetResources() const = 0;
 
+    // Looked up by the FNV hash of the name, see Hash::FNV
+    virtual ShaderUniform* FindUniform(uint32_t nameHash) const = 0;
+    virtual ShaderResource* FindResource(uint32_t nameHash) const = 0;
+
+    // Keywords are declared with "#pragma keywords", a variant compiles the same source with a #define
+    // for each one set in the mask. Variants are compiled on first request and cached by this shader.
+    // Materials bind variants with the layout of the shader they were created with, so a variant has to keep
+    // its material blocks and samplers. Keywords that change them belong to a shader type, like ANIMATED.
+    virtual Ref<Shader> GetVariant(uint32_t keywords) const = 0;
+    virtual uint32_t GetKeywords() const = 0;
+    // 0 when the shader does not declare the keyword
+    virtual uint32_t GetKeywordMask(const std::string& keyword) const = 0;
+
     static Ref<Shader> Create(const std::string& filepath, ShaderType type = ShaderType::None);
     static Ref<Shader> CreateFromString(const std::string& name, const std::string& source);
 
@@ -60,6 +76,10 @@ public:
     Ref<Shader> Load(const std::string& name, const std::string& filepath);
     Ref<Shader> Load(ShaderType type, const std::string& filepath);
 
+    // Reads and parses the files on worker threads, then queues every compile before any of them is waited on
+    void LoadBatch(std::initializer_list<std::string> filepaths);
+    void LoadBatch(std::initializer_list<std::pair<ShaderType, std::string>> shaders);
+
     Ref<Shader> Get(const std::string& name);
     Ref<Shader> Get(ShaderType type);
 
@@ -67,6 +87,7 @@ private:
     std::unordered_map<std::string, Ref<Shader>> m_Shaders;
     
     bool Exists(const std::string& name) const;
+    void LoadParallel(const std::vector<std::pair<ShaderType, std::string>>& shaders);
 };
 
 }
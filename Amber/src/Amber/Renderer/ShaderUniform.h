@@ -11,14 +11,26 @@ enum class ShaderDomain
     Vertex, Pixel
 };
 
+// A piece of a tightly packed value and where it lands in the uniform block, relative to the uniform's offset
+struct ShaderUniformSpan
+{
+    uint32_t SourceOffset;
+    uint32_t BlockOffset;
+    uint32_t Size;
+};
+
 class ShaderUniform : public RefCounted
 {
 public:
     virtual const std::string& GetName() const = 0;
+    // Size of the tightly packed value, the padded block layout is described by the spans
     virtual uint32_t GetSize() const = 0;
     virtual uint32_t GetCount() const = 0;
     virtual uint32_t GetOffset() const = 0;
     virtual ShaderDomain GetDomain() const = 0;
+    virtual const std::vector<ShaderUniformSpan>& GetSpans() const = 0;
+    // Position among the shader's material uniforms, counting both stages
+    virtual uint32_t GetIndex() const = 0;
 
 protected:
     virtual void SetOffset(uint32_t offset) = 0;
@@ -86,6 +98,8 @@ public:
     virtual const std::string& GetName() const = 0;
     virtual uint32_t GetRegister() const = 0;
     virtual uint32_t GetCount() const = 0;
+    // Keyword the shader ties to this texture, materials enable it while the texture is set
+    virtual uint32_t GetKeyword() const = 0;
 
 protected:
     virtual void SetRegister(uint32_t reg) = 0;
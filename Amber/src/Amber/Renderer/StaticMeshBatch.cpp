@@ -0,0 +1,137 @@
+#include "abpch.h"
+#include "StaticMeshBatch.h"
+
+#include <map>
+#include <tuple>
+
+namespace Amber
+{
+
+StaticMeshBatch::StaticMeshBatch(float chunkSize)
+    : m_ChunkSize(chunkSize)
+{
+}
+
+void StaticMeshBatch::Add(const Ref<Mesh>& mesh, const glm::mat4& transform)
+{
+    if (mesh->IsAnimated())
+        return;
+
+    m_Instances.push_back({ mesh, transform });
+}
+
+void StaticMeshBatch::Build()
+{
+    struct SubmeshInstance
+    {
+        Mesh* Mesh;
+        const Submesh* Submesh;
+        glm::mat4 Transform;
+        Math::AABB BoundingBox;
+    };
+
+    // Chunk coordinates, then material, so each chunk's draws end up next to each other
+    using GroupKey = std::tuple<int, int, int, MaterialInstance*>;
+    std::map<GroupKey, std::vector<SubmeshInstance>> groups;
+
+    for (auto& instance : m_Instances)
+    {
+        for (auto& submesh : instance.Mesh->GetSubmeshes())
+        {
+            glm::mat4 transform = instance.Transform * submesh.Transform;
+
+            Math::AABB aabb;
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                glm::vec3 corner(i & 1 ? submesh.BoundingBox.Max.x : submesh.BoundingBox.Min.x,
+                                 i & 2 ? submesh.BoundingBox.Max.y : submesh.BoundingBox.Min.y,
+                                 i & 4 ? submesh.BoundingBox.Max.z : submesh.BoundingBox.Min.z);
+                corner = transform * glm::vec4(corner, 1.0f);
+                aabb.Min = glm::min(aabb.Min, corner);
+                aabb.Max = glm::max(aabb.Max, corner);
+            }
+
+            glm::ivec3 cell = glm::ivec3(glm::floor((aabb.Min + aabb.Max) * 0.5f / m_ChunkSize));
+            auto material = instance.Mesh->GetMaterials()[submesh.MaterialIndex];
+            groups[{ cell.x, cell.y, cell.z, material.Raw() }].push_back({ instance.Mesh.Raw(), &submesh, transform, aabb });
+        }
+    }
+
+    std::vector<StaticVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::map<std::tuple<int, int, int>, uint32_t> chunkIndices;
+
+    for (auto& [key, submeshes] : groups)
+    {
+        auto [x, y, z, material] = key;
+
+        auto it = chunkIndices.find({ x, y, z });
+        if (it == chunkIndices.end())
+        {
+            it = chunkIndices.insert({ { x, y, z }, (uint32_t)m_Chunks.size() }).first;
+            m_Chunks.emplace_back();
+        }
+
+        auto& chunk = m_Chunks[it->second];
+        Draw draw = { submeshes[0].Mesh->GetMaterial(), submeshes[0].Mesh->GetMaterials()[submeshes[0].Submesh->MaterialIndex], (uint32_t)indices.size(), 0 };
+
+        for (auto& instance : submeshes)
+        {
+            const auto& mesh = *instance.Mesh;
+            const auto& submesh = *instance.Submesh;
+            glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(instance.Transform)));
+            glm::mat3 tangentTransform = glm::mat3(instance.Transform);
+
+            uint32_t baseVertex = (uint32_t)vertices.size();
+            uint32_t vertexCount = 0;
+            for (uint32_t i = 0; i < submesh.IndexCount / 3; i++)
+            {
+                const auto& index = mesh.m_Indices[submesh.BaseIndex / 3 + i];
+                indices.insert(indices.end(), { baseVertex + index.V0, baseVertex + index.V1, baseVertex + index.V2 });
+                vertexCount = glm::max(vertexCount, glm::max(index.V0, glm::max(index.V1, index.V2)) + 1);
+            }
+
+            for (uint32_t i = 0; i < vertexCount; i++)
+            {
+                StaticVertex vertex = mesh.m_StaticVertices[submesh.BaseVertex + i];
+                vertex.Position = instance.Transform * glm::vec4(vertex.Position, 1.0f);
+                vertex.Normal = glm::normalize(normalTransform * vertex.Normal);
+                vertex.Tangent = tangentTransform * vertex.Tangent;
+                vertex.Binormal = tangentTransform * vertex.Binormal;
+                vertices.push_back(vertex);
+            }
+
+            chunk.BoundingBox.Min = glm::min(chunk.BoundingBox.Min, instance.BoundingBox.Min);
+            chunk.BoundingBox.Max = glm::max(chunk.BoundingBox.Max, instance.BoundingBox.Max);
+        }
+
+        draw.IndexCount = (uint32_t)indices.size() - draw.BaseIndex;
+        chunk.Draws.push_back(draw);
+    }
+
+    m_Instances.clear();
+    if (m_Chunks.empty())
+        return;
+
+    m_VertexBuffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(StaticVertex));
+    m_IndexBuffer = IndexBuffer::Create(indices.data(), indices.size() * sizeof(uint32_t));
+
+    PipelineSpecification pipelineSpec;
+    pipelineSpec.Layout = {
+        { ShaderDataType::Float3, "a_Position" },
+        { ShaderDataType::Float2, "a_TexCoord" },
+        { ShaderDataType::Float3, "a_Normal" },
+        { ShaderDataType::Float3, "a_Tangent" },
+        { ShaderDataType::Float3, "a_Binormal" },
+    };
+    m_Pipeline = Pipeline::Create(pipelineSpec);
+}
+
+void StaticMeshBatch::Bind()
+{
+    m_VertexBuffer->Bind();
+    m_Pipeline->Bind();
+    m_IndexBuffer->Bind();
+}
+
+}
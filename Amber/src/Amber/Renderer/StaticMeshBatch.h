@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Amber/Core/Base.h"
+
+#include "Amber/Math/AABB.h"
+
+#include "Amber/Renderer/IndexBuffer.h"
+#include "Amber/Renderer/Material.h"
+#include "Amber/Renderer/Mesh.h"
+#include "Amber/Renderer/Pipeline.h"
+#include "Amber/Renderer/VertexBuffer.h"
+
+namespace Amber
+{
+
+// Static meshes pre-transformed into world space and merged into one vertex and index buffer.
+// Submeshes are grouped into a grid of chunks so they can still be culled, with one draw per chunk and material.
+class StaticMeshBatch : public RefCounted
+{
+public:
+    struct Draw
+    {
+        Ref<Material> BaseMaterial;
+        Ref<MaterialInstance> Material;
+        uint32_t BaseIndex;
+        uint32_t IndexCount;
+    };
+
+    struct Chunk
+    {
+        Math::AABB BoundingBox;
+        std::vector<Draw> Draws;
+    };
+
+    StaticMeshBatch(float chunkSize = 32.0f);
+
+    // Animated meshes can't be batched and are ignored
+    void Add(const Ref<Mesh>& mesh, const glm::mat4& transform);
+    // Merges everything added so far and uploads it
+    void Build();
+
+    void Bind();
+
+    bool IsEmpty() const { return m_Chunks.empty(); }
+    const std::vector<Chunk>& GetChunks() const { return m_Chunks; }
+
+private:
+    struct Instance
+    {
+        Ref<Mesh> Mesh;
+        glm::mat4 Transform;
+    };
+
+    float m_ChunkSize;
+    std::vector<Instance> m_Instances;
+    std::vector<Chunk> m_Chunks;
+
+    Ref<VertexBuffer> m_VertexBuffer;
+    Ref<IndexBuffer> m_IndexBuffer;
+    Ref<Pipeline> m_Pipeline;
+};
+
+}
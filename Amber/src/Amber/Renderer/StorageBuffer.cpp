@@ -0,0 +1,24 @@
+#include "abpch.h"
+#include "StorageBuffer.h"
+
+#include "Amber/Platform/OpenGL/OpenGLStorageBuffer.h"
+
+#include "Amber/Renderer/Renderer.h"
+
+namespace Amber
+{
+
+Ref<StorageBuffer> StorageBuffer::Create(size_t size)
+{
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::OpenGL:  return Ref<OpenGLStorageBuffer>::Create(size);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Storage buffers are not implemented for Vulkan yet!"); return nullptr;
+        case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
+    }
+
+    AB_CORE_ASSERT(false, "Unknown Renderer API");
+    return nullptr;
+}
+
+}
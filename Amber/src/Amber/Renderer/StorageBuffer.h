@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Amber/Core/Base.h"
+
+namespace Amber
+{
+
+class StorageBuffer : public RefCounted
+{
+public:
+    virtual ~StorageBuffer() = default;
+
+    virtual void Bind(uint32_t binding) const = 0;
+
+    // The data is copied, so only the given range has to stay valid until the call returns
+    virtual void SetData(const void* buffer, size_t size, uint32_t offset = 0) = 0;
+
+    virtual size_t GetSize() const = 0;
+    virtual uint32_t GetRendererID() const = 0;
+
+    static Ref<StorageBuffer> Create(size_t size);
+};
+
+}
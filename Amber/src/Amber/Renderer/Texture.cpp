@@ -13,6 +13,7 @@ Ref<Texture2D> Texture2D::Create(TextureFormat format, uint32_t width, uint32_t
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLTexture2D>::Create(format, width, height, wrap, filter, samples);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Textures are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -25,6 +26,7 @@ Ref<Texture2D> Texture2D::Create(const std::string& path, bool srgb, bool flip,
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLTexture2D>::Create(path, srgb, flip, wrap, filter);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Textures are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -37,6 +39,20 @@ Ref<TextureCube> TextureCube::Create(TextureFormat format, uint32_t width, uint3
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLTextureCube>::Create(format, width, height);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Textures are not implemented for Vulkan yet!"); return nullptr;
+        case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
+    }
+
+    AB_CORE_ASSERT(false, "Unknown Renderer API");
+    return nullptr;
+}
+
+Ref<TextureCube> TextureCube::Create(TextureFormat format, uint32_t width, uint32_t height, Buffer data)
+{
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::OpenGL:  return Ref<OpenGLTextureCube>::Create(format, width, height, std::move(data));
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Textures are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -49,6 +65,7 @@ Ref<TextureCube> TextureCube::Create(const std::string& path)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLTextureCube>::Create(path);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Textures are not implemented for Vulkan yet!"); return nullptr;
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -62,6 +79,7 @@ uint32_t Texture::GetBPP(TextureFormat format)
     {
         case TextureFormat::RGB: return 3;
         case TextureFormat::RGBA: return 4;
+        case TextureFormat::SRGBA: return 4;
     }
 
     return 0;
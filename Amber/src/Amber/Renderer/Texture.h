@@ -15,7 +15,10 @@ enum class TextureFormat
     RG,
     RGB,
     RGBA,
+    SRGBA,
     Float16,
+    R11G11B10F,
+    Depth,
     DepthStencil
 };
 
@@ -77,7 +80,11 @@ public:
 class TextureCube : public Texture
 {
 public:
+    // Reads back every mip level, each holding all six faces. Render thread only.
+    virtual Buffer GetData() const = 0;
+
     static Ref<TextureCube> Create(TextureFormat format, uint32_t width, uint32_t height);
+    static Ref<TextureCube> Create(TextureFormat format, uint32_t width, uint32_t height, Buffer data);
     static Ref<TextureCube> Create(const std::string& path);
 };
 
@@ -0,0 +1,24 @@
+#include "abpch.h"
+#include "UniformBuffer.h"
+
+#include "Amber/Platform/OpenGL/OpenGLUniformBuffer.h"
+
+#include "Amber/Renderer/Renderer.h"
+
+namespace Amber
+{
+
+Ref<UniformBuffer> UniformBuffer::Create(size_t size)
+{
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::OpenGL:  return Ref<OpenGLUniformBuffer>::Create(size);
+        case RendererAPI::API::Vulkan:  AB_CORE_ASSERT(false, "Uniform buffers are not implemented for Vulkan yet!"); return nullptr;
+        case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
+    }
+
+    AB_CORE_ASSERT(false, "Unknown Renderer API");
+    return nullptr;
+}
+
+}
@@ -2,6 +2,7 @@
 #include "VertexBuffer.h"
 
 #include "Amber/Platform/OpenGL/OpenGLVertexBuffer.h"
+#include "Amber/Platform/Vulkan/VulkanVertexBuffer.h"
 
 #include "Amber/Renderer/Renderer.h"
 
@@ -27,6 +28,7 @@ Ref<VertexBuffer> VertexBuffer::Create(size_t size, VertexBufferUsage usage)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create(size, usage);
+        case RendererAPI::API::Vulkan:  return Ref<VulkanVertexBuffer>::Create(size, usage);
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
@@ -39,6 +41,7 @@ Ref<VertexBuffer> VertexBuffer::Create(void* data, size_t size, VertexBufferUsag
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create(data, size, usage);
+        case RendererAPI::API::Vulkan:  return Ref<VulkanVertexBuffer>::Create(data, size, usage);
         case RendererAPI::API::None:    AB_CORE_ASSERT(false, "RendererAPI::None is not supported right now!"); return nullptr;
     }
 
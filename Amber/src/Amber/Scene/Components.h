@@ -58,6 +58,10 @@ struct CameraComponent
 struct MeshComponent
 {
     Ref<Amber::Mesh> Mesh;
+    // Never moves at runtime, so it can be merged into the scene's static batch
+    bool Static = false;
+    // Selected by the scene renderer each frame, not serialized
+    uint32_t LODIndex = 0;
 
     operator Ref<Amber::Mesh>() { return Mesh; }
     operator const Ref<Amber::Mesh>() const { return Mesh; }
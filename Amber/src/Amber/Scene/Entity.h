@@ -52,6 +52,13 @@ public:
         return m_Scene->m_Registry.get<T...>(m_EntityHandle);
     }
 
+    // For writes that observers of the component (the scene's GPU data) have to see
+    template<typename T>
+    T& PatchComponent()
+    {
+        return m_Scene->m_Registry.patch<T>(m_EntityHandle);
+    }
+
     template<typename T>
     T* GetComponentIfExists()
     {
@@ -64,7 +71,8 @@ public:
         return m_Scene->m_Registry.try_get<T>(m_EntityHandle);
     }
 
-    glm::mat4& Transform() { return m_Scene->m_Registry.get<TransformComponent>(m_EntityHandle); }
+    // Mutable access counts as a change for the GPU scene
+    glm::mat4& Transform() { return m_Scene->m_Registry.patch<TransformComponent>(m_EntityHandle); }
     const glm::mat4& GetTransform() const { return m_Scene->m_Registry.get<TransformComponent>(m_EntityHandle); }
 
     UUID GetUUID() const { return GetComponent<IDComponent>(); }
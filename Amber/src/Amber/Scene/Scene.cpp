@@ -6,6 +6,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 
+#include "Amber/Math/Rect.h"
 #include "Amber/Math/Transforms.h"
 
 #include "Amber/Renderer/SceneRenderer.h"
@@ -96,10 +97,12 @@ void OnScriptComponentDestroy(entt::registry& registry, entt::entity entity)
     ScriptEngine::OnScriptComponentDestroyed(sceneID, entityID);
 }
 
-Environment Environment::Load(const std::string& filepath)
+Environment Environment::Load(const std::string& filepath, const EnvironmentSettings& settings)
 {
-    auto [irradiance, radiance] = SceneRenderer::CreateEnvironmentMap(filepath);
-    return { filepath, irradiance, radiance };
+    auto job = Ref<EnvironmentMapJob>::Create(filepath, settings);
+    job->Run();
+
+    return job->GetEnvironment();
 }
 
 Scene::Scene(const std::string& debugName, const std::string& assetPath)
@@ -107,6 +110,18 @@ Scene::Scene(const std::string& debugName, const std::string& assetPath)
 {
     m_Registry.on_construct<ScriptComponent>().connect<&OnScriptComponentConstruct>();
     m_Registry.on_destroy<ScriptComponent>().connect<&OnScriptComponentDestroy>();
+    m_Registry.on_destroy<MeshComponent>().connect<&Scene::OnMeshComponentDestroy>(*this);
+
+    m_GPUScene = Ref<GPUScene>::Create();
+    m_GPUSceneObserver.connect(m_Registry, entt::collector
+        .group<MeshComponent, TransformComponent>()
+        .update<TransformComponent>().where<MeshComponent>()
+        .update<MeshComponent>().where<TransformComponent>());
+
+    m_Registry.on_destroy<SpriteRendererComponent>().connect<&Scene::OnSpriteRendererComponentDestroy>(*this);
+    m_SpriteObserver.connect(m_Registry, entt::collector
+        .group<SpriteRendererComponent, TransformComponent>()
+        .update<TransformComponent>().where<SpriteRendererComponent>());
 
     m_SceneEntity = m_Registry.create();
     m_Registry.emplace<SceneComponent>(m_SceneEntity, m_SceneID);
@@ -122,6 +137,10 @@ Scene::Scene(const std::string& debugName, const std::string& assetPath)
 Scene::~Scene()
 {
     m_Registry.on_destroy<ScriptComponent>().disconnect();
+    m_Registry.on_destroy<MeshComponent>().disconnect(*this);
+    m_Registry.on_destroy<SpriteRendererComponent>().disconnect(*this);
+    m_GPUSceneObserver.disconnect();
+    m_SpriteObserver.disconnect();
     m_Registry.clear();
 
     g_ActiveScenes.erase(m_SceneID);
@@ -132,7 +151,6 @@ void Scene::Init()
 {
     auto skyboxShader = Shader::Create("assets/shaders/Skybox.glsl");
     m_SkyboxMaterial = Ref<MaterialInstance>::Create(Ref<Material>::Create(skyboxShader));
-    m_SkyboxMaterial->SetFlag(MaterialFlag::DepthTest, false);
 }
 
 void Scene::OnUpdate(Timestep ts)
@@ -169,8 +187,70 @@ void Scene::OnUpdate(Timestep ts)
     }
 }
 
+void Scene::UpdateGPUScene()
+{
+    for (auto entity : m_GPUSceneObserver)
+    {
+        auto [meshComponent, transformComponent] = m_Registry.get<MeshComponent, TransformComponent>(entity);
+        if (meshComponent.Mesh)
+            m_GPUScene->SetObject((uint32_t)entity, transformComponent, meshComponent.Mesh->GetBoundingBox());
+        else
+            m_GPUScene->RemoveObject((uint32_t)entity);
+    }
+    m_GPUSceneObserver.clear();
+
+    m_GPUScene->Upload();
+}
+
+void Scene::OnMeshComponentDestroy(entt::registry& registry, entt::entity entity)
+{
+    m_GPUScene->RemoveObject((uint32_t)entity);
+}
+
+void Scene::OnSpriteRendererComponentDestroy(entt::registry& registry, entt::entity entity)
+{
+    m_SpriteGrid.Remove((uint32_t)entity);
+}
+
+void Scene::SubmitSprites(const glm::mat4& viewProjection)
+{
+    for (auto entity : m_SpriteObserver)
+    {
+        const glm::mat4& transform = m_Registry.get<TransformComponent>(entity);
+        m_SpriteGrid.Update((uint32_t)entity, Math::Rect::FromQuad(transform));
+
+        float extent = glm::abs(transform[0].z * 0.5f) + glm::abs(transform[1].z * 0.5f);
+        m_SpriteMinZ = glm::min(m_SpriteMinZ, transform[3].z - extent);
+        m_SpriteMaxZ = glm::max(m_SpriteMaxZ, transform[3].z + extent);
+    }
+    m_SpriteObserver.clear();
+
+    auto submit = [this](entt::entity entity) {
+        auto [spriteRendererComponent, transformComponent] = m_Registry.get<SpriteRendererComponent, TransformComponent>(entity);
+        SceneRenderer::SubmitSprite({ transformComponent.Transform,
+                                        spriteRendererComponent.Color,
+                                        spriteRendererComponent.TexCoords,
+                                        spriteRendererComponent.Texture,
+                                        spriteRendererComponent.TilingFactor });
+    };
+
+    // Perspective views are culled with the footprint of the frustum over the depths sprites use
+    Math::Rect view;
+    if (!Math::Rect::FromView(viewProjection, m_SpriteMinZ, m_SpriteMaxZ, view))
+        return;
+
+    // Sorted so overlapping sprites keep a stable order from frame to frame
+    m_VisibleSprites.clear();
+    m_SpriteGrid.Query(view, m_VisibleSprites);
+    std::sort(m_VisibleSprites.begin(), m_VisibleSprites.end());
+    for (uint32_t entity : m_VisibleSprites)
+        submit((entt::entity)entity);
+}
+
 void Scene::OnRenderEditor(Timestep ts, const EditorCamera& camera, std::vector<Entity>& selectionContext)
 {
+    UpdatePendingEnvironment();
+    UpdateGPUScene();
     m_SkyboxMaterial->Set("u_TextureLod", m_SkyboxLOD);
 
     Entity sceneCameraEntity;
@@ -186,19 +266,15 @@ void Scene::OnRenderEditor(Timestep ts, const EditorCamera& camera, std::vector<
     if (!cameraEntities.empty())
         sceneCameraEntity = *cameraEntities.rbegin();
 
-    Ref<Texture2D> cameraPreview = nullptr;
+    SceneRenderer::BeginScene(this, { camera, camera.GetViewMatrix() });
+
     if (sceneCameraEntity)
     {
-        OnRenderRuntime(ts, &sceneCameraEntity);
-
-        auto& colorBuffer = SceneRenderer::GetFinalColorBuffer();
-        cameraPreview = Texture2D::Create(
-            colorBuffer->GetFormat(), colorBuffer->GetWidth(), colorBuffer->GetHeight());
-        colorBuffer->CopyTo(cameraPreview);
+        SceneCamera& sceneCamera = sceneCameraEntity.GetComponent<CameraComponent>();
+        sceneCamera.Update();
+        SceneRenderer::SubmitCameraPreview({ sceneCamera, glm::inverse(sceneCameraEntity.GetComponent<TransformComponent>().Transform) });
     }
 
-    SceneRenderer::BeginScene(this, { camera, camera.GetViewMatrix() });
-
     auto meshEntities = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
     for (auto entity : meshEntities)
     {
@@ -206,24 +282,16 @@ void Scene::OnRenderEditor(Timestep ts, const EditorCamera& camera, std::vector<
         if (meshComponent.Mesh)
         {
             meshComponent.Mesh->OnUpdate(ts);
+            int32_t objectIndex = m_GPUScene->GetSlot((uint32_t)entity);
             auto res = std::find(selectionContext.begin(), selectionContext.end(), entity);
             if (res != selectionContext.end())
-                SceneRenderer::SubmitSelectedMesh(meshComponent, transformComponent);
+                SceneRenderer::SubmitSelectedMesh(meshComponent, transformComponent, &meshComponent.LODIndex, objectIndex);
             else
-                SceneRenderer::SubmitMesh(meshComponent, transformComponent);
+                SceneRenderer::SubmitMesh(meshComponent, transformComponent, nullptr, &meshComponent.LODIndex, objectIndex);
         }
     }
 
-    auto spriteEntities = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
-    for (auto entity : spriteEntities)
-    {
-        auto& [spriteRendererComponent, transformComponent] = spriteEntities.get<SpriteRendererComponent, TransformComponent>(entity);
-        SceneRenderer::SubmitSprite({ transformComponent.Transform,
-                                        spriteRendererComponent.Color,
-                                        spriteRendererComponent.TexCoords,
-                                        spriteRendererComponent.Texture,
-                                        spriteRendererComponent.TilingFactor });
-    }
+    SubmitSprites(camera.GetProjectionMatrix() * camera.GetViewMatrix());
 
     for (auto& entity : cameraEntities)
     {
@@ -244,7 +312,7 @@ void Scene::OnRenderEditor(Timestep ts, const EditorCamera& camera, std::vector<
         previewMaterial->Set("u_ViewProjection", glm::mat4(1.0f));
 
         glm::vec3 position(0.75f, -0.75f, 0.0f);
-        previewMaterial->Set("u_AlbedoTexture", cameraPreview);
+        previewMaterial->Set("u_AlbedoTexture", SceneRenderer::GetCameraPreviewColorBuffer());
         previewMaterial->Set("u_Transform", glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(0.2f, 0.2f, 1.0f)));
 
         RenderCommand::SetStencilFunction(ComparisonFunc::Always, 2, 0xff);
@@ -280,6 +348,8 @@ void Scene::OnRenderEditor(Timestep ts, const EditorCamera& camera, std::vector<
 
 void Scene::OnRenderRuntime(Timestep ts, Entity* sceneCameraEntity)
 {
+    UpdatePendingEnvironment();
+    UpdateGPUScene();
     m_SkyboxMaterial->Set("u_TextureLod", m_SkyboxLOD);
 
     Entity cameraEntity = sceneCameraEntity ? *sceneCameraEntity : GetMainCameraEntity();
@@ -295,23 +365,17 @@ void Scene::OnRenderRuntime(Timestep ts, Entity* sceneCameraEntity)
     for (auto entity : meshEntities)
     {
         auto& [meshComponent, transformComponent] = meshEntities.get<MeshComponent, TransformComponent>(entity);
-        if (meshComponent.Mesh)
+        if (meshComponent.Mesh && !(m_StaticBatch && meshComponent.Static && !meshComponent.Mesh->IsAnimated()))
         {
             meshComponent.Mesh->OnUpdate(ts);
-            SceneRenderer::SubmitMesh(meshComponent, transformComponent);
+            SceneRenderer::SubmitMesh(meshComponent, transformComponent, nullptr, &meshComponent.LODIndex, m_GPUScene->GetSlot((uint32_t)entity));
         }
     }
 
-    auto spriteEntities = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
-    for (auto entity : spriteEntities)
-    {
-        auto& [spriteRendererComponent, transformComponent] = spriteEntities.get<SpriteRendererComponent, TransformComponent>(entity);
-        SceneRenderer::SubmitSprite({ transformComponent.Transform,
-                                        spriteRendererComponent.Color,
-                                        spriteRendererComponent.TexCoords,
-                                        spriteRendererComponent.Texture,
-                                        spriteRendererComponent.TilingFactor });
-    }
+    if (m_StaticBatch)
+        SceneRenderer::SubmitStaticBatch(m_StaticBatch);
+
+    SubmitSprites(camera.GetProjectionMatrix() * viewMatrix);
 
     SceneRenderer::EndScene();
 }
@@ -408,6 +472,8 @@ void Scene::OnRuntimeStart()
         }
     }
 
+    BuildStaticBatch();
+
     m_IsPlaying = true;
 }
 
@@ -422,10 +488,30 @@ void Scene::OnRuntimeStop()
     }
 
     delete[] m_PhysicsEntityBuffer;
+    m_StaticBatch = nullptr;
     
     m_IsPlaying = false;
 }
 
+void Scene::BuildStaticBatch()
+{
+    auto batch = Ref<StaticMeshBatch>::Create();
+
+    auto meshEntities = m_Registry.view<MeshComponent, TransformComponent>();
+    for (auto entity : meshEntities)
+    {
+        auto [meshComponent, transformComponent] = meshEntities.get<MeshComponent, TransformComponent>(entity);
+        if (meshComponent.Mesh && meshComponent.Static)
+            batch->Add(meshComponent.Mesh, transformComponent.Transform);
+    }
+
+    batch->Build();
+
+    m_StaticBatch = nullptr;
+    if (!batch->IsEmpty())
+        m_StaticBatch = batch;
+}
+
 void Scene::OnEvent(Event& e)
 {
 }
@@ -436,6 +522,23 @@ void Scene::SetEnvironment(const Environment& environment)
     SetSkybox(environment.RadianceMap);
 }
 
+void Scene::SetEnvironmentAsync(const std::string& filepath, const EnvironmentSettings& settings, float rotation)
+{
+    m_PendingEnvironment = Ref<EnvironmentMapJob>::Create(filepath, settings);
+    m_PendingEnvironmentRotation = rotation;
+    SceneRenderer::SubmitEnvironmentJob(m_PendingEnvironment);
+}
+
+void Scene::UpdatePendingEnvironment()
+{
+    if (!m_PendingEnvironment || !m_PendingEnvironment->IsComplete())
+        return;
+
+    SetEnvironment(m_PendingEnvironment->GetEnvironment());
+    m_Environment.Rotation = m_PendingEnvironmentRotation;
+    m_PendingEnvironment = nullptr;
+}
+
 void Scene::SetSkybox(const Ref<TextureCube>& skybox)
 {
     m_Skybox = skybox;
@@ -6,9 +6,13 @@
 
 #include "Amber/Editor/EditorCamera.h"
 
+#include "Amber/Math/LooseGrid.h"
+
 #include "Amber/Renderer/Camera.h"
+#include "Amber/Renderer/GPUScene.h"
 #include "Amber/Renderer/Material.h"
 #include "Amber/Renderer/Mesh.h"
+#include "Amber/Renderer/StaticMeshBatch.h"
 #include "Amber/Renderer/Texture.h"
 
 #include "Amber/Scene/SceneCamera.h"
@@ -18,14 +22,23 @@
 namespace Amber
 {
 
+struct EnvironmentSettings
+{
+    uint32_t CubemapSize = 2048;
+    uint32_t SampleCount = 1024;
+    bool UseIrradianceSH = false;
+};
+
 struct Environment
 {
     std::string Filepath;;
     Ref<TextureCube> IrradianceMap;
     Ref<TextureCube> RadianceMap;
+    std::array<glm::vec3, 9> IrradianceSH = {};
     float Rotation = 0.0f;
+    EnvironmentSettings Settings;
 
-    static Environment Load(const std::string& filepath);
+    static Environment Load(const std::string& filepath, const EnvironmentSettings& settings = {});
 };
 
 struct Light
@@ -36,6 +49,7 @@ struct Light
 };
 
 class Entity;
+class EnvironmentMapJob;
 using EntityMap = std::unordered_map<UUID, Entity>;
 
 class Scene : public RefCounted
@@ -54,6 +68,11 @@ public:
     void OnRuntimeStart();
     void OnRuntimeStop();
 
+    // Merges the static mesh entities, which are then no longer drawn individually
+    void BuildStaticBatch();
+
+    const Ref<GPUScene>& GetGPUScene() const { return m_GPUScene; }
+
     Entity CreateEntity(const std::string& name = "");
     Entity CreateEntity(UUID uuid, const std::string& name = "");
     Entity DuplicateEntity(const Entity& entity);
@@ -94,6 +113,9 @@ public:
     
     void SetViewportSize(uint32_t width, uint32_t height) { m_ViewportWidth = width; m_ViewportHeight = height; }
     void SetEnvironment(const Environment& environment);
+    // Keeps the current environment until the new one has been generated
+    void SetEnvironmentAsync(const std::string& filepath, const EnvironmentSettings& settings = {}, float rotation = 0.0f);
+    bool IsEnvironmentLoading() const { return m_PendingEnvironment; }
     void SetLight(const Light& light) { m_Light = light; }
     void SetSkyboxLOD(float lod) { m_SkyboxLOD = lod; }
 
@@ -105,6 +127,16 @@ public:
 
     static Ref<Scene> GetScene(UUID uuid);
 
+private:
+    void UpdatePendingEnvironment();
+    // Writes the mesh entities whose transform or mesh changed since the last frame
+    void UpdateGPUScene();
+    void OnMeshComponentDestroy(entt::registry& registry, entt::entity entity);
+    void OnSpriteRendererComponentDestroy(entt::registry& registry, entt::entity entity);
+    // Only sprites inside the view are submitted. For perspective views the area is the frustum's
+    // footprint between the lowest and highest sprite depth seen so far.
+    void SubmitSprites(const glm::mat4& viewProjection);
+
 private:
     UUID m_SceneID;
     std::string m_AssetPath;
@@ -112,14 +144,27 @@ private:
     entt::registry m_Registry;
     entt::entity m_SceneEntity;
 
+    Ref<GPUScene> m_GPUScene;
+    entt::observer m_GPUSceneObserver;
+
+    Math::LooseGrid m_SpriteGrid;
+    entt::observer m_SpriteObserver;
+    std::vector<uint32_t> m_VisibleSprites;
+    // Z range sprites have been seen in, only ever grows so it stays conservative
+    float m_SpriteMinZ = std::numeric_limits<float>::max(), m_SpriteMaxZ = -std::numeric_limits<float>::max();
+
     EntityMap m_EntityIDMap;
 
     uint32_t m_ViewportWidth = 1280;
     uint32_t m_ViewportHeight = 720;
 
     Environment m_Environment;
+    Ref<EnvironmentMapJob> m_PendingEnvironment;
+    float m_PendingEnvironmentRotation = 0.0f;
     Light m_Light;
 
+    Ref<StaticMeshBatch> m_StaticBatch;
+
     Ref<TextureCube> m_Skybox;
     Ref<MaterialInstance> m_SkyboxMaterial;
     float m_SkyboxLOD = 1.0f;
@@ -462,6 +462,7 @@ struct convert<MeshComponent>
 
         node["ShaderType"] = (uint32_t)shader->GetType();
         node["ShaderName"] = shader->GetName();
+        node["Static"] = rhs.Static;
 
         return node;
     }
@@ -482,6 +483,9 @@ struct convert<MeshComponent>
         else
             rhs.Mesh = Ref<Mesh>::Create(filepath);
 
+        if (node["Static"])
+            rhs.Static = node["Static"].as<bool>();
+
         auto material = rhs.Mesh->GetMaterial();
         auto shaderType = (ShaderType)node["ShaderType"].as<uint32_t>();
         std::string shaderName = node["ShaderName"].as<std::string>();
@@ -513,6 +517,9 @@ Emitter& operator<<(Emitter& out, const MeshComponent& meshComponent)
     out << Key << "ShaderName";
     out << Value << shader->GetName();
 
+    out << Key << "Static";
+    out << Value << meshComponent.Static;
+
     out << EndMap;
     return out;
 }
@@ -959,6 +966,15 @@ void SceneSerializer::SerializeEnvironment(YAML::Emitter& out)
     out << YAML::Key << "Rotation";
     out << YAML::Value << environment.Rotation;
 
+    out << YAML::Key << "CubemapSize";
+    out << YAML::Value << environment.Settings.CubemapSize;
+
+    out << YAML::Key << "SampleCount";
+    out << YAML::Value << environment.Settings.SampleCount;
+
+    out << YAML::Key << "IrradianceSH";
+    out << YAML::Value << environment.Settings.UseIrradianceSH;
+
     out << YAML::Key << "Light";
     out << YAML::Value << m_Scene->GetLight();
 
@@ -1035,7 +1051,16 @@ bool SceneSerializer::Deserialize(const std::string& filepath)
     if (environment)
     {
         std::string envPath = environment["AssetPath"].as<std::string>();
-        m_Scene->SetEnvironment(Environment::Load(envPath));
+
+        EnvironmentSettings settings;
+        if (environment["CubemapSize"])
+            settings.CubemapSize = environment["CubemapSize"].as<uint32_t>();
+        if (environment["SampleCount"])
+            settings.SampleCount = environment["SampleCount"].as<uint32_t>();
+        if (environment["IrradianceSH"])
+            settings.UseIrradianceSH = environment["IrradianceSH"].as<bool>();
+
+        m_Scene->SetEnvironment(Environment::Load(envPath, settings));
 
         Light light = environment["Light"].as<Light>();
         m_Scene->SetLight(light);
@@ -1069,7 +1094,7 @@ bool SceneSerializer::Deserialize(const std::string& filepath)
             if (meshNode)
             {
                 auto mesh = meshNode.as<MeshComponent>();
-                deserializedEntity.AddComponent<MeshComponent>(mesh.Mesh);
+                deserializedEntity.AddComponent<MeshComponent>(mesh.Mesh, mesh.Static);
             }
 
             auto spriteRendererNode = entity["SpriteRendererComponent"];
@@ -115,7 +115,7 @@ void Amber_TransformComponent_GetTransform(uint64_t entityID, glm::mat4* outTran
 void Amber_TransformComponent_SetTransform(uint64_t entityID, glm::mat4* inTransform)
 {
     Entity entity = GetEntity(entityID);
-    auto& transform = entity.GetComponent<TransformComponent>();
+    auto& transform = entity.PatchComponent<TransformComponent>();
     memcpy(glm::value_ptr(transform.Transform), inTransform, sizeof(glm::mat4));
 }
 
@@ -129,7 +129,7 @@ Ref<Mesh>* Amber_MeshComponent_GetMesh(uint64_t entityID)
 void Amber_MeshComponent_SetMesh(uint64_t entityID, Ref<Mesh>* inMesh)
 {
     Entity entity = GetEntity(entityID);
-    auto& mesh = entity.GetComponent<MeshComponent>();
+    auto& mesh = entity.PatchComponent<MeshComponent>();
     mesh.Mesh = inMesh ? *inMesh : nullptr;
 }
 
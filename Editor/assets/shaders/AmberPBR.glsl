@@ -1,3 +1,6 @@
+#pragma keywords ANIMATED
+#pragma keywords ALBEDO_MAP=u_AlbedoTexture NORMAL_MAP=u_NormalTexture METALNESS_MAP=u_MetalnessTexture ROUGHNESS_MAP=u_RoughnessTexture
+
 #type vertex
 #version 440 core
 
@@ -6,6 +9,10 @@ layout(location = 1) in vec2 a_TexCoords;
 layout(location = 2) in vec3 a_Normal;
 layout(location = 3) in vec3 a_Tangent;
 layout(location = 4) in vec3 a_Binormal;
+#ifdef ANIMATED
+layout(location = 5) in ivec4 a_BoneIndices;
+layout(location = 6) in vec4 a_BoneWeights;
+#endif
 
 out VertexOutput
 {
@@ -16,42 +23,92 @@ out VertexOutput
 	vec3 LightDir;
 } vs_Output;
 
-uniform vec3 u_ViewPosition;
-uniform vec3 u_LightDirection;
-
-uniform mat3 u_NormalTransform;
-uniform mat4 u_Transform;
-uniform mat4 u_ViewProjection;
+struct SceneObject
+{
+	mat4 Transform;
+	mat4 NormalTransform;
+	vec4 BoundsMin;
+	vec4 BoundsMax;
+};
 
-uniform bool u_NormalTexToggle;
+layout(std430, binding = 0) readonly buffer SceneObjects
+{
+	SceneObject Objects[];
+} s_Scene;
 
-void main()
+struct SubmeshTransform
 {
-	vec4 worldPos = u_Transform * vec4(a_Position, 1.0);
-	vec3 N = a_Normal;
+	mat4 Transform;
+	mat4 NormalTransform;
+};
 
-	vs_Output.Normal = u_NormalTransform * N;
-	vs_Output.TexCoord = a_TexCoords;
-	if (u_NormalTexToggle)
-	{
-		vec3 T = a_Tangent;
-		T = normalize(T - dot(T, N) * N);
+layout(std430, binding = 1) readonly buffer SubmeshTransforms
+{
+	SubmeshTransform Submeshes[];
+} s_Mesh;
 
-		vec3 B = a_Binormal;
-		B = normalize(B - dot(B, T) * T - dot(B, N) * N);
+// u_ObjectIndex is the slot in the scene objects, -1 when u_Transform holds the entity transform.
+// u_SubmeshIndex is the slot in the mesh's submesh transforms, -1 for pre-transformed vertices
+layout(std140) uniform VertexMaterial
+{
+	vec3 u_ViewPosition;
+	vec3 u_LightDirection;
+	mat3 u_NormalTransform;
+	mat4 u_Transform;
+	mat4 u_ViewProjection;
+	int u_ObjectIndex;
+	int u_SubmeshIndex;
+#ifdef ANIMATED
+	mat4 u_BoneTransform[100];
+#endif
+};
 
-		mat3 TBN = inverse(u_NormalTransform * mat3(T, B, N));
-		vs_Output.FragPos = TBN * vec3(worldPos);
-		vs_Output.ViewPos = TBN * u_ViewPosition;
-		vs_Output.LightDir = TBN * u_LightDirection;
+void main()
+{
+#ifdef ANIMATED
+	mat4 boneTransform = u_BoneTransform[a_BoneIndices[0]] * a_BoneWeights[0];
+	boneTransform += u_BoneTransform[a_BoneIndices[1]] * a_BoneWeights[1];
+	boneTransform += u_BoneTransform[a_BoneIndices[2]] * a_BoneWeights[2];
+	boneTransform += u_BoneTransform[a_BoneIndices[3]] * a_BoneWeights[3];
+#else
+	mat4 boneTransform = mat4(1.0);
+#endif
+
+	mat4 transform = u_Transform;
+	mat3 normalTransform = u_NormalTransform;
+	if (u_ObjectIndex >= 0)
+	{
+		transform = s_Scene.Objects[u_ObjectIndex].Transform;
+		normalTransform = mat3(s_Scene.Objects[u_ObjectIndex].NormalTransform);
 	}
-	else
+	if (u_SubmeshIndex >= 0)
 	{
-		vs_Output.FragPos = vec3(worldPos);
-		vs_Output.ViewPos = u_ViewPosition;
-		vs_Output.LightDir = u_LightDirection;
+		transform = transform * s_Mesh.Submeshes[u_SubmeshIndex].Transform;
+		normalTransform = normalTransform * mat3(s_Mesh.Submeshes[u_SubmeshIndex].NormalTransform);
 	}
 
+	vec4 worldPos = transform * boneTransform * vec4(a_Position, 1.0);
+	vec3 N = a_Normal;
+
+	vs_Output.Normal = normalTransform * mat3(boneTransform) * N;
+	vs_Output.TexCoord = a_TexCoords;
+#ifdef NORMAL_MAP
+	vec3 T = a_Tangent;
+	T = normalize(T - dot(T, N) * N);
+
+	vec3 B = a_Binormal;
+	B = normalize(B - dot(B, T) * T - dot(B, N) * N);
+
+	mat3 TBN = inverse(normalTransform * mat3(boneTransform) * mat3(T, B, N));
+	vs_Output.FragPos = TBN * vec3(worldPos);
+	vs_Output.ViewPos = TBN * u_ViewPosition;
+	vs_Output.LightDir = TBN * u_LightDirection;
+#else
+	vs_Output.FragPos = vec3(worldPos);
+	vs_Output.ViewPos = u_ViewPosition;
+	vs_Output.LightDir = u_LightDirection;
+#endif
+
 	gl_Position = u_ViewProjection * worldPos;
 }
 
@@ -74,28 +131,30 @@ struct Light
 	vec3 Radiance;
 	float Multiplier;
 };
-uniform Light u_Light;
+
+layout(std140) uniform PixelMaterial
+{
+	Light u_Light;
+
+	vec3 u_Albedo;
+	float u_Metalness;
+	float u_Roughness;
+
+	vec3 u_IrradianceSH[9];
+	bool u_UseIrradianceSH;
+
+	float u_EnvironmentRotation;
+};
 
 uniform sampler2D u_AlbedoTexture;
 uniform sampler2D u_NormalTexture;
 uniform sampler2D u_MetalnessTexture;
 uniform sampler2D u_RoughnessTexture;
 
-uniform vec3 u_Albedo;
-uniform float u_Metalness;
-uniform float u_Roughness;
-
-uniform bool u_AlbedoTexToggle;
-uniform bool u_NormalTexToggle;
-uniform bool u_MetalnessTexToggle;
-uniform bool u_RoughnessTexToggle;
-
 uniform samplerCube u_IrradianceTexture;
 uniform samplerCube u_RadianceTexture;
 uniform sampler2D u_BRDFLUT;
 
-uniform float u_EnvironmentRotation;
-
 struct PBRParameters
 {
 	vec3 Albedo;
@@ -181,11 +240,24 @@ vec3 Lighting(vec3 F0)
 	return brdf * u_Light.Radiance * u_Light.Multiplier * NdotL;
 }
 
+// L2 spherical harmonics, pre-convolved with the cosine lobe on the CPU
+vec3 IrradianceSH(vec3 N)
+{
+	vec3 irradiance =
+		0.282095 * u_IrradianceSH[0] +
+		0.488603 * (N.y * u_IrradianceSH[1] + N.z * u_IrradianceSH[2] + N.x * u_IrradianceSH[3]) +
+		1.092548 * (N.x * N.y * u_IrradianceSH[4] + N.y * N.z * u_IrradianceSH[5] + N.x * N.z * u_IrradianceSH[7]) +
+		0.315392 * (3.0 * N.z * N.z - 1.0) * u_IrradianceSH[6] +
+		0.546274 * (N.x * N.x - N.y * N.y) * u_IrradianceSH[8];
+
+	return max(irradiance, vec3(0.0));
+}
+
 vec3 IBL(vec3 F0, vec3 R)
 {
 	vec3 k_S = FresnelSchlickRoughness(m_Params.NdotV, F0, m_Params.Roughness);
 	vec3 k_D = (1.0 - k_S) * (1.0 - m_Params.Metalness);
-	vec3 irradiance = texture(u_IrradianceTexture, m_Params.Normal).rgb;
+	vec3 irradiance = u_UseIrradianceSH ? IrradianceSH(m_Params.Normal) : texture(u_IrradianceTexture, m_Params.Normal).rgb;
 	vec3 diffuse = k_D * irradiance * m_Params.Albedo;
 
 	const float MAX_RADIANCE_LOD = textureQueryLevels(u_RadianceTexture) - 1.0;
@@ -198,12 +270,28 @@ vec3 IBL(vec3 F0, vec3 R)
 
 void main()
 {
-	m_Params.Albedo    = u_AlbedoTexToggle ? texture(u_AlbedoTexture, fs_Input.TexCoord).rgb : u_Albedo;
-	m_Params.Metalness = u_MetalnessTexToggle ? texture(u_MetalnessTexture, fs_Input.TexCoord).r : u_Metalness;
-	m_Params.Roughness = u_RoughnessTexToggle ? texture(u_RoughnessTexture, fs_Input.TexCoord).r : u_Roughness;
+#ifdef ALBEDO_MAP
+	m_Params.Albedo = texture(u_AlbedoTexture, fs_Input.TexCoord).rgb;
+#else
+	m_Params.Albedo = u_Albedo;
+#endif
+#ifdef METALNESS_MAP
+	m_Params.Metalness = texture(u_MetalnessTexture, fs_Input.TexCoord).r;
+#else
+	m_Params.Metalness = u_Metalness;
+#endif
+#ifdef ROUGHNESS_MAP
+	m_Params.Roughness = texture(u_RoughnessTexture, fs_Input.TexCoord).r;
+#else
+	m_Params.Roughness = u_Roughness;
+#endif
 	m_Params.Roughness = max(m_Params.Roughness, 0.05);
 
-	m_Params.Normal = u_NormalTexToggle ? texture(u_NormalTexture, fs_Input.TexCoord).rgb * 2.0 - 1.0 : normalize(fs_Input.Normal);
+#ifdef NORMAL_MAP
+	m_Params.Normal = texture(u_NormalTexture, fs_Input.TexCoord).rgb * 2.0 - 1.0;
+#else
+	m_Params.Normal = normalize(fs_Input.Normal);
+#endif
 	m_Params.View = normalize(fs_Input.ViewPos - fs_Input.FragPos);
 	m_Params.NdotV = clamp(dot(m_Params.Normal, m_Params.View), 0.0, 1.0);
 
@@ -7,6 +7,8 @@ layout(binding = 0) uniform samplerCube u_EnvironmentMap;
 layout(binding = 0, rgba16f) restrict writeonly uniform imageCube o_FilteredMap;
 
 layout(location = 0) uniform float roughness;
+layout(location = 1) uniform int u_SampleCount;
+layout(location = 2) uniform int u_FaceOffset;
 
 const float PI = 3.14159265359;
 
@@ -60,18 +62,18 @@ float NDF_GGX(float NdotH, float roughness)
     return num / max(denom, 0.0000001);
 }
 
-vec3 GetCubeMapTexCoords()
+vec3 GetCubeMapTexCoords(int face)
 {
 	vec2 st = gl_GlobalInvocationID.xy / vec2(imageSize(o_FilteredMap));
 	vec2 uv = 2.0 * vec2(st.x, 1.0 - st.y) - vec2(1.0);
 
 	vec3 ret;
-	if (gl_GlobalInvocationID.z == 0)		ret = vec3(  1.0, uv.y, -uv.x);
-	else if (gl_GlobalInvocationID.z == 1)	ret = vec3( -1.0, uv.y,  uv.x);
-	else if (gl_GlobalInvocationID.z == 2)	ret = vec3( uv.x,  1.0, -uv.y);
-	else if (gl_GlobalInvocationID.z == 3)	ret = vec3( uv.x, -1.0,  uv.y);
-	else if (gl_GlobalInvocationID.z == 4)	ret = vec3( uv.x, uv.y,   1.0);
-	else if (gl_GlobalInvocationID.z == 5)	ret = vec3(-uv.x, uv.y,  -1.0);
+	if (face == 0)		ret = vec3(  1.0, uv.y, -uv.x);
+	else if (face == 1)	ret = vec3( -1.0, uv.y,  uv.x);
+	else if (face == 2)	ret = vec3( uv.x,  1.0, -uv.y);
+	else if (face == 3)	ret = vec3( uv.x, -1.0,  uv.y);
+	else if (face == 4)	ret = vec3( uv.x, uv.y,   1.0);
+	else if (face == 5)	ret = vec3(-uv.x, uv.y,  -1.0);
 
 	return normalize(ret);
 }
@@ -85,10 +87,11 @@ void main()
     const vec2 INPUT_SIZE = vec2(textureSize(u_EnvironmentMap, 0));
     const float W_t = (4.0 * PI) / (6.0 * INPUT_SIZE.x * INPUT_SIZE.y);
 
-    const uint NUM_SAMPLES = 1024u;
+    const uint NUM_SAMPLES = uint(u_SampleCount);
     const float INV_NUM_SAMPLES = 1.0 / float(NUM_SAMPLES);
 
-    vec3 N = GetCubeMapTexCoords();
+    int face = int(gl_GlobalInvocationID.z) + u_FaceOffset;
+    vec3 N = GetCubeMapTexCoords(face);
     vec3 V = N;
 
     float totalWeight = 0.0;
@@ -114,5 +117,5 @@ void main()
     }
     color /= totalWeight;
 
-    imageStore(o_FilteredMap, ivec3(gl_GlobalInvocationID), vec4(color, 1.0));
+    imageStore(o_FilteredMap, ivec3(gl_GlobalInvocationID.xy, face), vec4(color, 1.0));
 }
\ No newline at end of file
@@ -6,8 +6,11 @@ layout(location = 1) in vec2 a_TexCoords;
 
 out vec2 v_TexCoords;
 
-uniform mat4 u_Transform;
-uniform mat4 u_ViewProjection;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_Transform;
+	mat4 u_ViewProjection;
+};
 
 void main()
 {
@@ -18,12 +21,18 @@ void main()
 #type fragment
 #version 440 core
 
+// Nothing here changes depth, so pixels hidden by opaque geometry are rejected before shading
+layout(early_fragment_tests) in;
+
 in vec2 v_TexCoords;
 
 out vec4 o_Color;
 
-uniform float u_Resolution;
-uniform float u_Scale;
+layout(std140) uniform PixelMaterial
+{
+	float u_Resolution;
+	float u_Scale;
+};
 
 float Grid(vec2 st, float res)
 {
@@ -0,0 +1,57 @@
+#type vertex
+#version 440 core
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoords;
+
+out vec2 v_TexCoords;
+
+void main()
+{
+	v_TexCoords = a_TexCoords;
+	gl_Position = vec4(a_Position.xy, 0.0, 1.0);
+}
+
+#type fragment
+#version 440 core
+
+out vec4 o_Color;
+
+uniform sampler2D u_Texture;
+layout(std140) uniform PixelMaterial
+{
+	vec2 u_RenderSize;
+	int u_Step;
+};
+
+void main()
+{
+	ivec2 coord = ivec2(gl_FragCoord.xy);
+	ivec2 renderSize = ivec2(u_RenderSize);
+
+	vec2 nearestOffset = vec2(0.0);
+	float nearestDistance = -1.0;
+	for (int y = -1; y <= 1; y++)
+	{
+		for (int x = -1; x <= 1; x++)
+		{
+			ivec2 sampleCoord = coord + ivec2(x, y) * u_Step;
+			if (any(lessThan(sampleCoord, ivec2(0))) || any(greaterThanEqual(sampleCoord, renderSize)))
+				continue;
+
+			vec3 seed = texelFetch(u_Texture, sampleCoord, 0).xyz;
+			if (seed.z < 0.5)
+				continue;
+
+			vec2 offset = seed.xy + vec2(x, y) * float(u_Step);
+			float sqrDistance = dot(offset, offset);
+			if (nearestDistance < 0.0 || sqrDistance < nearestDistance)
+			{
+				nearestOffset = offset;
+				nearestDistance = sqrDistance;
+			}
+		}
+	}
+
+	o_Color = vec4(nearestOffset, nearestDistance < 0.0 ? 0.0 : 1.0, 1.0);
+}
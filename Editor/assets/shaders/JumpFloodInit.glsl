@@ -0,0 +1,27 @@
+#type vertex
+#version 440 core
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoords;
+
+out vec2 v_TexCoords;
+
+void main()
+{
+	v_TexCoords = a_TexCoords;
+	gl_Position = vec4(a_Position.xy, 0.0, 1.0);
+}
+
+#type fragment
+#version 440 core
+
+out vec4 o_Color;
+
+uniform sampler2D u_MaskTexture;
+
+// Every masked pixel seeds itself: xy holds the offset to the nearest seed, z marks it as valid
+void main()
+{
+	float mask = texelFetch(u_MaskTexture, ivec2(gl_FragCoord.xy), 0).a;
+	o_Color = vec4(0.0, 0.0, mask > 0.5 ? 1.0 : 0.0, 1.0);
+}
@@ -0,0 +1,44 @@
+#type vertex
+#version 440 core
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoords;
+
+out vec2 v_TexCoords;
+
+void main()
+{
+	v_TexCoords = a_TexCoords;
+	gl_Position = vec4(a_Position.xy, 0.0, 1.0);
+}
+
+#type fragment
+#version 440 core
+
+in vec2 v_TexCoords;
+
+out vec4 o_Color;
+
+uniform sampler2D u_Texture;
+uniform sampler2D u_MaskTexture;
+layout(std140) uniform PixelMaterial
+{
+	vec2 u_ViewportScale;
+	vec3 u_Color;
+	float u_Width;
+};
+
+void main()
+{
+	ivec2 coord = ivec2(v_TexCoords * u_ViewportScale * vec2(textureSize(u_Texture, 0)));
+
+	if (texelFetch(u_MaskTexture, coord, 0).a > 0.5)
+		discard;
+
+	vec3 seed = texelFetch(u_Texture, coord, 0).xyz;
+	if (seed.z < 0.5)
+		discard;
+
+	float alpha = clamp(u_Width - length(seed.xy) + 0.5, 0.0, 1.0);
+	o_Color = vec4(u_Color, alpha);
+}
@@ -8,7 +8,10 @@ layout(location = 1) in vec4 a_Color;
 
 out vec4 v_Color;
 
-uniform mat4 u_ViewProjection;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_ViewProjection;
+};
 
 void main()
 {
@@ -5,8 +5,11 @@ layout(location = 0) in vec3 a_Position;
 
 out vec3 v_Position;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_ViewProjection;
+	mat4 u_Transform;
+};
 
 void main()
 {
@@ -22,11 +25,14 @@ in vec3 v_Position;
 
 out vec4 o_Color;
 
-uniform vec3 u_Color;
-uniform vec2 u_Center;
-uniform vec2 u_Size;;
-uniform float u_Radius;
-uniform bool u_Border;
+layout(std140) uniform PixelMaterial
+{
+	vec3 u_Color;
+	vec2 u_Center;
+	vec2 u_Size;
+	float u_Radius;
+	bool u_Border;
+};
 
 void main()
 {
@@ -5,10 +5,13 @@ layout(location = 0) in vec3 a_Position;
 layout(location = 5) in ivec4 a_BoneIndices;
 layout(location = 6) in vec4 a_BoneWeights;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_ViewProjection;
+	mat4 u_Transform;
+	mat4 u_BoneTransform[100];
+};
 
-uniform mat4 u_BoneTransform[100];
 
 void main()
 {
@@ -25,7 +28,10 @@ void main()
 
 out vec4 o_Color;
 
-uniform vec3 u_Color;
+layout(std140) uniform PixelMaterial
+{
+	vec3 u_Color;
+};
 
 void main()
 {
@@ -12,7 +12,10 @@ out vec2 v_TexCoord;
 out float v_TexIndex;
 out float v_TilingFactor;
     
-uniform mat4 u_ViewProjection;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_ViewProjection;
+};
 
 void main() 
 {
@@ -19,27 +19,80 @@ in vec2 v_TexCoords;
 
 out vec4 o_Color;
 
-uniform float u_Exposure;
-uniform sampler2DMS u_Texture;
-uniform int u_TextureSamples;
+layout(std140) uniform PixelMaterial
+{
+	float u_Exposure;
+	vec2 u_ViewportScale;
+	int u_FXAA;
+};
+
+uniform sampler2D u_Texture;
+
+const float c_Gamma = 2.2;
 
-vec4 MultisampleTexture(sampler2DMS tex, ivec2 texCoords, int samples)
+vec3 SampleTonemapped(vec2 texCoords)
 {
-	vec4 color = vec4(0.0);
-	for (int i = 0; i < samples; i++)
-		color += texelFetch(tex, texCoords, i);
+	// Keep taps inside the rendered sub-rect
+	vec2 halfTexel = 0.5 / vec2(textureSize(u_Texture, 0));
+	texCoords = clamp(texCoords, halfTexel, u_ViewportScale - halfTexel);
 
-	return color / float(samples);
+	vec3 color = texture(u_Texture, texCoords).rgb;
+	color = vec3(1.0) - exp(-color * u_Exposure);
+	return pow(color, vec3(1.0 / c_Gamma));
 }
 
-void main()
+float Luma(vec3 color)
 {
-	float gamma = 2.2;
+	return dot(color, vec3(0.299, 0.587, 0.114));
+}
 
-	ivec2 texSize = textureSize(u_Texture);
-	ivec2 texCoords = ivec2(v_TexCoords * texSize);
-	vec3 color = MultisampleTexture(u_Texture, texCoords, u_TextureSamples).rgb;
-	color = vec3(1.0) - exp(-color * u_Exposure);
+// FXAA runs on tonemapped taps so edge detection sees display-space contrast
+vec3 FXAA(vec2 texCoords)
+{
+	const float reduceMin = 1.0 / 128.0;
+	const float reduceMul = 1.0 / 8.0;
+	const float spanMax = 8.0;
+
+	vec2 texelSize = 1.0 / vec2(textureSize(u_Texture, 0));
+
+	vec3 rgbM = SampleTonemapped(texCoords);
+	float lumaNW = Luma(SampleTonemapped(texCoords + vec2(-1.0, -1.0) * texelSize));
+	float lumaNE = Luma(SampleTonemapped(texCoords + vec2( 1.0, -1.0) * texelSize));
+	float lumaSW = Luma(SampleTonemapped(texCoords + vec2(-1.0,  1.0) * texelSize));
+	float lumaSE = Luma(SampleTonemapped(texCoords + vec2( 1.0,  1.0) * texelSize));
+	float lumaM = Luma(rgbM);
+
+	float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+	float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+	if (lumaMax - lumaMin < max(0.0312, lumaMax * 0.125))
+		return rgbM;
+
+	vec2 dir;
+	dir.x = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+	dir.y =  ((lumaNW + lumaSW) - (lumaNE + lumaSE));
+
+	float dirReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25 * reduceMul, reduceMin);
+	float rcpDirMin = 1.0 / (min(abs(dir.x), abs(dir.y)) + dirReduce);
+	dir = clamp(dir * rcpDirMin, vec2(-spanMax), vec2(spanMax)) * texelSize;
+
+	vec3 rgbA = 0.5 * (
+		SampleTonemapped(texCoords + dir * (1.0 / 3.0 - 0.5)) +
+		SampleTonemapped(texCoords + dir * (2.0 / 3.0 - 0.5)));
+	vec3 rgbB = rgbA * 0.5 + 0.25 * (
+		SampleTonemapped(texCoords + dir * -0.5) +
+		SampleTonemapped(texCoords + dir * 0.5));
+
+	float lumaB = Luma(rgbB);
+	if (lumaB < lumaMin || lumaB > lumaMax)
+		return rgbA;
+
+	return rgbB;
+}
+
+void main()
+{
+	vec2 texCoords = v_TexCoords * u_ViewportScale;
 
-	o_Color = vec4(pow(color, vec3(1.0 / gamma)), 1.0);
+	vec3 color = u_FXAA != 0 ? FXAA(texCoords) : SampleTonemapped(texCoords);
+	o_Color = vec4(color, 1.0);
 }
\ No newline at end of file
@@ -5,7 +5,10 @@ layout(location = 0) in vec2 a_Position;
 
 out vec3 v_TexCoords;
 
-uniform mat4 u_InverseVP;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_InverseVP;
+};
 
 void main()
 {
@@ -23,8 +26,11 @@ in vec3 v_TexCoords;
 out vec4 o_Color;
 
 uniform samplerCube u_Texture;
-uniform float u_TextureLod;
-uniform float u_Rotation;
+layout(std140) uniform PixelMaterial
+{
+	float u_TextureLod;
+	float u_Rotation;
+};
 
 vec3 RotateAboutY(float angle, vec3 vec)
 {
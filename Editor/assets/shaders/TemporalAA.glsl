@@ -0,0 +1,72 @@
+#type vertex
+#version 440 core
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoords;
+
+out vec2 v_TexCoords;
+
+void main()
+{
+	v_TexCoords = a_TexCoords;
+	gl_Position = vec4(a_Position.xy, 0.0, 1.0);
+}
+
+#type fragment
+#version 440 core
+
+in vec2 v_TexCoords;
+
+out vec4 o_Color;
+
+uniform sampler2D u_Texture;
+uniform sampler2D u_HistoryTexture;
+uniform sampler2D u_DepthTexture;
+
+layout(std140) uniform PixelMaterial
+{
+	mat4 u_ReprojectionMatrix;
+	vec2 u_ViewportScale;
+	vec2 u_HistoryViewportScale;
+	float u_BlendFactor;
+};
+
+void main()
+{
+	vec2 texCoords = v_TexCoords * u_ViewportScale;
+	vec3 current = texture(u_Texture, texCoords).rgb;
+	if (u_BlendFactor >= 1.0)
+	{
+		o_Color = vec4(current, 1.0);
+		return;
+	}
+
+	// Neighbourhood bounds used to reject stale history
+	vec2 texelSize = 1.0 / vec2(textureSize(u_Texture, 0));
+	vec3 minColor = current;
+	vec3 maxColor = current;
+	for (int y = -1; y <= 1; y++)
+	{
+		for (int x = -1; x <= 1; x++)
+		{
+			vec3 color = texture(u_Texture, texCoords + vec2(x, y) * texelSize).rgb;
+			minColor = min(minColor, color);
+			maxColor = max(maxColor, color);
+		}
+	}
+
+	// Reproject through depth into the previous frame
+	float depth = texture(u_DepthTexture, texCoords).r;
+	vec4 previousPosition = u_ReprojectionMatrix * vec4(vec3(v_TexCoords, depth) * 2.0 - 1.0, 1.0);
+	vec2 previousTexCoords = (previousPosition.xy / previousPosition.w) * 0.5 + 0.5;
+	if (any(lessThan(previousTexCoords, vec2(0.0))) || any(greaterThan(previousTexCoords, vec2(1.0))))
+	{
+		o_Color = vec4(current, 1.0);
+		return;
+	}
+
+	vec3 history = texture(u_HistoryTexture, previousTexCoords * u_HistoryViewportScale).rgb;
+	history = clamp(history, minColor, maxColor);
+
+	o_Color = vec4(mix(history, current, u_BlendFactor), 1.0);
+}
\ No newline at end of file
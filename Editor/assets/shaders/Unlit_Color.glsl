@@ -3,8 +3,11 @@
 
 layout(location = 0) in vec3 a_Position;
 
-uniform mat4 u_Transform;
-uniform mat4 u_ViewProjection;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_Transform;
+	mat4 u_ViewProjection;
+};
 
 void main()
 {
@@ -16,7 +19,10 @@ void main()
 
 out vec4 o_Color;
 
-uniform vec3 u_Albedo;
+layout(std140) uniform PixelMaterial
+{
+	vec3 u_Albedo;
+};
 
 void main()
 {
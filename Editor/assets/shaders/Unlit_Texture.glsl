@@ -6,8 +6,11 @@ layout(location = 1) in vec2 a_TexCoord;
 
 out vec2 v_TexCoord;
 
-uniform mat4 u_Transform;
-uniform mat4 u_ViewProjection;
+layout(std140) uniform VertexMaterial
+{
+	mat4 u_Transform;
+	mat4 u_ViewProjection;
+};
 
 void main()
 {
@@ -260,6 +260,92 @@ void EditorLayer::DrawViewportSettingsPanel()
     Property("Grid Size", m_GridSize, 1.0f, 100.0f);
     Property("Bounding Box", m_ShowBoundingBoxes);
 
+    ImGui::Separator();
+    auto& options = SceneRenderer::GetOptions();
+    Property("Outline Color", options.SelectionOutlineColor, PropertyFlags::ColorProperty);
+    Property("Outline Width", options.SelectionOutlineWidth, 1.0f, 16.0f);
+
+    ImGui::Separator();
+    Property("LOD Bias", options.LODBias, 0.1f, 4.0f);
+    Property("LOD Hysteresis", options.LODHysteresis, 0.0f, 0.5f);
+
+    ImGui::Separator();
+    Property("Dynamic Resolution", options.DynamicResolution);
+    if (options.DynamicResolution)
+    {
+        Property("GPU Budget (ms)", options.TargetGPUTime, 1.0f, 33.0f);
+        Property("Min Scale", options.MinResolutionScale, 0.25f, options.MaxResolutionScale, 0.01f);
+        Property("Max Scale", options.MaxResolutionScale, options.MinResolutionScale, 1.0f, 0.01f);
+
+        std::string scale = std::to_string((int)(SceneRenderer::GetResolutionScale() * 100.0f)) + "%";
+        Property("Resolution Scale", scale.c_str());
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Anti-aliasing");
+    ImGui::NextColumn();
+    ImGui::PushItemWidth(-1);
+    const char* antiAliasingMethods[] = { "None", "MSAA", "FXAA", "TAA" };
+    int antiAliasing = (int)options.AntiAliasing;
+    if (ImGui::Combo("##AntiAliasing", &antiAliasing, antiAliasingMethods, IM_ARRAYSIZE(antiAliasingMethods)))
+        options.AntiAliasing = (AntiAliasingMethod)antiAliasing;
+    ImGui::PopItemWidth();
+    ImGui::NextColumn();
+
+    if (options.AntiAliasing == AntiAliasingMethod::MSAA)
+    {
+        ImGui::Text("Samples");
+        ImGui::NextColumn();
+        ImGui::PushItemWidth(-1);
+        const char* sampleCounts[] = { "1x", "2x", "4x", "8x" };
+        int sampleIndex = (int)glm::log2((float)options.MSAASamples);
+        if (ImGui::Combo("##MSAASamples", &sampleIndex, sampleCounts, IM_ARRAYSIZE(sampleCounts)))
+            options.MSAASamples = 1 << sampleIndex;
+        ImGui::PopItemWidth();
+        ImGui::NextColumn();
+    }
+    else if (options.AntiAliasing == AntiAliasingMethod::TAA)
+    {
+        Property("History Blend", options.TAABlendFactor, 0.02f, 1.0f, 0.01f);
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Scene Color");
+    ImGui::NextColumn();
+    ImGui::PushItemWidth(-1);
+    const char* sceneColorFormats[] = { "RGBA16F", "R11G11B10F" };
+    int sceneColorFormat = options.SceneColorFormat == FramebufferFormat::R11G11B10F ? 1 : 0;
+    if (ImGui::Combo("##SceneColorFormat", &sceneColorFormat, sceneColorFormats, IM_ARRAYSIZE(sceneColorFormats)))
+        options.SceneColorFormat = sceneColorFormat ? FramebufferFormat::R11G11B10F : FramebufferFormat::RGBA16F;
+    ImGui::PopItemWidth();
+    ImGui::NextColumn();
+
+    ImGui::Text("Composite");
+    ImGui::NextColumn();
+    ImGui::PushItemWidth(-1);
+    const char* compositeFormatNames[] = { "RGBA8", "RGBA8 sRGB", "RGBA16F" };
+    const FramebufferFormat compositeFormats[] = { FramebufferFormat::RGBA8, FramebufferFormat::RGBA8_SRGB, FramebufferFormat::RGBA16F };
+    int compositeFormat = (int)(std::find(std::begin(compositeFormats), std::end(compositeFormats), options.CompositeFormat) - std::begin(compositeFormats));
+    if (ImGui::BeginCombo("##CompositeFormat", compositeFormatNames[compositeFormat]))
+    {
+        // Without decode control the composite would be gamma corrected twice when sampled
+        bool srgbSupported = RendererAPI::GetCapabilities().HasExtension("GL_EXT_texture_sRGB_decode");
+        for (int i = 0; i < IM_ARRAYSIZE(compositeFormats); i++)
+        {
+            if (compositeFormats[i] == FramebufferFormat::RGBA8_SRGB && !srgbSupported)
+                continue;
+
+            if (ImGui::Selectable(compositeFormatNames[i], i == compositeFormat))
+                options.CompositeFormat = compositeFormats[i];
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::PopItemWidth();
+    ImGui::NextColumn();
+
+    ImGui::Separator();
+    Property("Camera Preview Rate", options.CameraPreviewRefreshRate, 1.0f, 60.0f, 1.0f);
+
     EndPropertyGrid();
 
     char* label = m_SelectionMode == SelectionMode::Entity ? "Entity" : "Mesh";
@@ -282,7 +368,7 @@ void EditorLayer::DrawEnvironmentSettingsPanel()
         std::string filename = FileSystem::OpenFileDialog("HDR (*.hdr):*.hdr", "Select Environment Map");
         if (!filename.empty())
         {
-            m_EditorScene->SetEnvironment(Environment::Load(filename));
+            m_EditorScene->SetEnvironmentAsync(filename);
             m_EditorScene->SetLight({ glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f), 1.0f });
         }
     }
@@ -293,6 +379,37 @@ void EditorLayer::DrawEnvironmentSettingsPanel()
     BeginPropertyGrid(2, (int)s_StringHasher("light"));
     if (!environment.Filepath.empty())
     {
+        EnvironmentSettings settings = environment.Settings;
+
+        ImGui::Text("Cubemap Size");
+        ImGui::NextColumn();
+        ImGui::PushItemWidth(-1);
+        const char* cubemapSizes[] = { "256", "512", "1024", "2048" };
+        int sizeIndex = glm::clamp((int)glm::log2((float)settings.CubemapSize) - 8, 0, 3);
+        if (ImGui::Combo("##CubemapSize", &sizeIndex, cubemapSizes, IM_ARRAYSIZE(cubemapSizes)))
+            settings.CubemapSize = 256 << sizeIndex;
+        ImGui::PopItemWidth();
+        ImGui::NextColumn();
+
+        ImGui::Text("Filter Samples");
+        ImGui::NextColumn();
+        ImGui::PushItemWidth(-1);
+        const char* sampleCounts[] = { "256", "512", "1024", "2048" };
+        int sampleIndex = glm::clamp((int)glm::log2((float)settings.SampleCount) - 8, 0, 3);
+        if (ImGui::Combo("##FilterSamples", &sampleIndex, sampleCounts, IM_ARRAYSIZE(sampleCounts)))
+            settings.SampleCount = 256 << sampleIndex;
+        ImGui::PopItemWidth();
+        ImGui::NextColumn();
+
+        Property("SH Irradiance", settings.UseIrradianceSH);
+
+        if (settings.CubemapSize != environment.Settings.CubemapSize || settings.SampleCount != environment.Settings.SampleCount ||
+            settings.UseIrradianceSH != environment.Settings.UseIrradianceSH)
+            m_EditorScene->SetEnvironmentAsync(environment.Filepath, settings, environment.Rotation);
+
+        if (m_EditorScene->IsEnvironmentLoading())
+            Property("Status", "Generating...");
+
         Property("Environment Rotation", environment.Rotation, -360.0f, 360.0f);
         Property("Skybox LOD", m_EditorScene->GetSkyboxLOD(), 0.0f, 11.0f);
         Property("Exposure", m_EditorCamera.Exposure(), 0.0f, 5.0f);
@@ -307,7 +307,7 @@ void SceneHierarchyPanel::DrawComponents(Entity& entity)
         if (changed)
         {
             glm::quat rotation(glm::radians(orientation));
-            transformComponent.Transform = glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(rotation) * glm::scale(glm::mat4(1.0f), scale);
+            entity.Transform() = glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(rotation) * glm::scale(glm::mat4(1.0f), scale);
             m_EntityMap[entity].Orientation = orientation;
         }
 
@@ -316,7 +316,7 @@ void SceneHierarchyPanel::DrawComponents(Entity& entity)
     }
     ImGui::Separator();
 
-    DrawComponent<MeshComponent>("Mesh", entity, [](MeshComponent& component) {
+    DrawComponent<MeshComponent>("Mesh", entity, [&entity](MeshComponent& component) {
         BeginPropertyGrid(3);
 
         if (component.Mesh)
@@ -328,11 +328,15 @@ void SceneHierarchyPanel::DrawComponents(Entity& entity)
         {
             std::string filepath = FileSystem::OpenFileDialog("FBX (*.fbx):*.fbx", "Select Mesh");
             if (!filepath.empty())
-                component.Mesh = Ref<Mesh>::Create(filepath);
+                entity.PatchComponent<MeshComponent>().Mesh = Ref<Mesh>::Create(filepath);
         }
         ImGui::NextColumn();
 
         EndPropertyGrid();
+
+        BeginPropertyGrid();
+        Property("Static", component.Static);
+        EndPropertyGrid();
     });
 
     DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [](SpriteRendererComponent& component) {
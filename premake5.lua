@@ -30,6 +30,29 @@ IncludeDir["yaml_cpp"] = "Amber/vendor/yaml-cpp/include"
 LibraryDir = {}
 LibraryDir["mono"] = "vendor/mono/lib"
 
+-- The Vulkan backend builds against the LunarG SDK. An installed SDK is found through VULKAN_SDK,
+-- otherwise the SDK is downloaded and installed into Amber/vendor/VulkanSDK on the first run
+VULKAN_SDK_VERSION = "1.3.250.1"
+VULKAN_SDK = os.getenv("VULKAN_SDK")
+if VULKAN_SDK == nil then
+    VULKAN_SDK = path.getabsolute("Amber/vendor/VulkanSDK")
+    if os.host() == "windows" and not os.isdir(VULKAN_SDK .. "/Include/vulkan") then
+        local installer = path.getabsolute("Amber/vendor/VulkanSDK-Installer.exe")
+        local url = "https://sdk.lunarg.com/sdk/download/" .. VULKAN_SDK_VERSION .. "/windows/VulkanSDK-" .. VULKAN_SDK_VERSION .. "-Installer.exe"
+
+        print("Downloading Vulkan SDK " .. VULKAN_SDK_VERSION .. "...")
+        local result = http.download(url, installer)
+        if result ~= "OK" then
+            error("Could not download the Vulkan SDK from " .. url .. ": " .. result)
+        end
+
+        os.execute('"' .. path.translate(installer) .. '" --root "' .. path.translate(VULKAN_SDK) .. '" --accept-licenses --default-answer --confirm-command install')
+        os.remove(installer)
+    end
+end
+IncludeDir["VulkanSDK"] = VULKAN_SDK .. "/Include"
+LibraryDir["VulkanSDK"] = VULKAN_SDK .. "/Lib"
+
 group "Dependencies"
     include "Amber/vendor/Box2D"
     include "Amber/vendor/GLFW"
@@ -72,6 +95,7 @@ project "Amber"
         "%{IncludeDir.ImGui}",
         "%{IncludeDir.mono}",
         "%{IncludeDir.stb}",
+        "%{IncludeDir.VulkanSDK}",
         "%{IncludeDir.yaml_cpp}"
     }
     links
@@ -80,7 +104,8 @@ project "Amber"
         "GLFW",
         "Glad",
         "ImGui",
-        "opengl32.lib"
+        "opengl32.lib",
+        "%{LibraryDir.VulkanSDK}/vulkan-1.lib"
     }
 
     defines